@@ -0,0 +1,306 @@
+// -----------------------------------------------------------------------------
+// merton_bench.cpp
+// -----------------------------------------------------------------------------
+//
+// Replay benchmark for OnlineMertonCalibrator. Ticks come from a raw or
+// compact tick file (mmap, see tick_file.hpp / compact_tick_file.hpp; the
+// format is detected from the magic) or from a seeded synthetic Merton path, and
+// are replayed either as fast as possible or at the recorded pace. Each
+// public call is timed individually with steady_clock (which adds ~20 ns per
+// sample) and reported as p50 / p99 / p99.9 / max.
+//
+// Usage:
+//   merton_bench [--ticks FILE] [--write FILE [--compact]] [--n N] [--seed S]
+//                [--speed X] [--async] [--optimizer coordinate|lbfgsb|em|online_em|online_sgd]
+//                [--eval direct|log_sum_exp|fast] [--window N] [--fv-every N]
+//
+//   --ticks FILE   replay FILE instead of a synthetic path
+//   --write FILE   write the synthetic path to FILE and exit
+//   --compact      write it in the compact delta-encoded format
+//   --speed X      replay at X times the recorded pace (0 = full speed)
+// -----------------------------------------------------------------------------
+
+#include "compact_tick_file.hpp"
+#include "merton_online_calibrator.hpp"
+#include "merton_path.hpp"
+#include "tick_file.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    std::string ticks_path;
+    std::string write_path;
+    bool compact = false;
+    merton::PathConfig path;
+    double speed = 0.0;
+    bool async = false;
+    merton::OptimizerMode optimizer = merton::OptimizerMode::coordinate_search;
+    merton::MixtureEval eval = merton::MixtureEval::direct;
+    std::size_t window = 4096;
+    std::size_t fv_every = 1;
+};
+
+const char* optimizer_name(merton::OptimizerMode mode) {
+    switch (mode) {
+        case merton::OptimizerMode::lbfgsb:
+            return "lbfgsb";
+        case merton::OptimizerMode::em:
+            return "em";
+        case merton::OptimizerMode::online_em:
+            return "online_em";
+        case merton::OptimizerMode::online_sgd:
+            return "online_sgd";
+        case merton::OptimizerMode::coordinate_search:
+            break;
+    }
+    return "coordinate";
+}
+
+const char* eval_name(merton::MixtureEval eval) {
+    switch (eval) {
+        case merton::MixtureEval::log_sum_exp:
+            return "log_sum_exp";
+        case merton::MixtureEval::fast:
+            return "fast";
+        case merton::MixtureEval::direct:
+            break;
+    }
+    return "direct";
+}
+
+/// Per-method latency samples (ns); percentiles are taken once at the end.
+class LatencySamples {
+public:
+    explicit LatencySamples(const char* name, std::size_t reserve = 0) : name_(name) { ns_.reserve(reserve); }
+
+    void add(Clock::duration d) {
+        ns_.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(d).count());
+    }
+
+    void print() {
+        if (ns_.empty()) {
+            std::printf("%-30s %10d\n", name_, 0);
+            return;
+        }
+        std::sort(ns_.begin(), ns_.end());
+        auto pct = [&](double q) {
+            const auto i = static_cast<std::size_t>(q * static_cast<double>(ns_.size() - 1));
+            return static_cast<long long>(ns_[i]);
+        };
+        std::printf("%-30s %10zu %10lld %10lld %10lld %12lld\n", name_, ns_.size(), pct(0.50), pct(0.99), pct(0.999),
+                    static_cast<long long>(ns_.back()));
+    }
+
+private:
+    const char* name_;
+    std::vector<std::int64_t> ns_;
+};
+
+void usage() {
+    std::fprintf(stderr,
+                 "usage: merton_bench [--ticks FILE] [--write FILE [--compact]] [--n N] [--seed S] [--speed X]\n"
+                 "                    [--async] [--optimizer coordinate|lbfgsb|em|online_em|online_sgd]\n"
+                 "                    [--eval direct|log_sum_exp|fast] [--window N] [--fv-every N]\n");
+}
+
+bool parse(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        auto value = [&]() -> const char* { return i + 1 < argc ? argv[++i] : nullptr; };
+        const char* v = nullptr;
+        if (arg == "--async") {
+            opt.async = true;
+        } else if (arg == "--compact") {
+            opt.compact = true;
+        } else if (arg == "--ticks" && (v = value())) {
+            opt.ticks_path = v;
+        } else if (arg == "--write" && (v = value())) {
+            opt.write_path = v;
+        } else if (arg == "--n" && (v = value())) {
+            opt.path.ticks = std::strtoull(v, nullptr, 10);
+        } else if (arg == "--seed" && (v = value())) {
+            opt.path.seed = std::strtoull(v, nullptr, 10);
+        } else if (arg == "--speed" && (v = value())) {
+            opt.speed = std::strtod(v, nullptr);
+        } else if (arg == "--window" && (v = value())) {
+            opt.window = std::strtoull(v, nullptr, 10);
+        } else if (arg == "--fv-every" && (v = value())) {
+            opt.fv_every = std::max<std::size_t>(1, std::strtoull(v, nullptr, 10));
+        } else if (arg == "--optimizer" && (v = value())) {
+            if (std::strcmp(v, "lbfgsb") == 0) {
+                opt.optimizer = merton::OptimizerMode::lbfgsb;
+            } else if (std::strcmp(v, "coordinate") == 0) {
+                opt.optimizer = merton::OptimizerMode::coordinate_search;
+            } else if (std::strcmp(v, "em") == 0) {
+                opt.optimizer = merton::OptimizerMode::em;
+            } else if (std::strcmp(v, "online_em") == 0) {
+                opt.optimizer = merton::OptimizerMode::online_em;
+            } else if (std::strcmp(v, "online_sgd") == 0) {
+                opt.optimizer = merton::OptimizerMode::online_sgd;
+            } else {
+                return false;
+            }
+        } else if (arg == "--eval" && (v = value())) {
+            if (std::strcmp(v, "direct") == 0) {
+                opt.eval = merton::MixtureEval::direct;
+            } else if (std::strcmp(v, "log_sum_exp") == 0) {
+                opt.eval = merton::MixtureEval::log_sum_exp;
+            } else if (std::strcmp(v, "fast") == 0) {
+                opt.eval = merton::MixtureEval::fast;
+            } else {
+                return false;
+            }
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parse(argc, argv, opt)) {
+        usage();
+        return 2;
+    }
+
+    // Synthetic defaults: 20 jumps/year of ~1% on top of 60% vol.
+    const merton::MertonParams truth{0.60, 20.0, -0.002, 0.01};
+
+    std::vector<merton::TickRecord> synthetic;
+    merton::MappedTickFile file;
+    std::span<const merton::TickRecord> ticks;
+    if (!opt.ticks_path.empty() && merton::is_compact_tick_file(opt.ticks_path)) {
+        merton::CompactTickReader reader;
+        if (!reader.open(opt.ticks_path) || !reader.decode_all(synthetic)) {
+            std::fprintf(stderr, "cannot decode %s\n", opt.ticks_path.c_str());
+            return 1;
+        }
+        ticks = synthetic;
+    } else if (!opt.ticks_path.empty()) {
+        if (!file.open(opt.ticks_path)) {
+            std::fprintf(stderr, "cannot map %s: %s\n", opt.ticks_path.c_str(), std::strerror(errno));
+            return 1;
+        }
+        ticks = file.ticks();
+    } else {
+        synthetic = merton::simulate_merton_path(truth, opt.path);
+        ticks = synthetic;
+        if (!opt.write_path.empty()) {
+            bool written = false;
+            if (opt.compact) {
+                merton::CompactTickWriter writer;
+                written = writer.open(opt.write_path, 2.0);  // 0.5 price grid
+                for (const merton::TickRecord& t : ticks) {
+                    written = written && writer.append(t.price, t.epoch_us);
+                }
+                written = writer.close() && written;
+            } else {
+                written = merton::write_tick_file(opt.write_path, ticks);
+            }
+            if (!written) {
+                std::fprintf(stderr, "cannot write %s\n", opt.write_path.c_str());
+                return 1;
+            }
+            std::printf("wrote %zu ticks to %s\n", ticks.size(), opt.write_path.c_str());
+            return 0;
+        }
+    }
+    if (ticks.empty()) {
+        std::fprintf(stderr, "no ticks\n");
+        return 1;
+    }
+
+    merton::CalibratorConfig cfg;
+    cfg.window_size = opt.window;
+    cfg.async_recalibration = opt.async;
+    cfg.optimizer = opt.optimizer;
+    cfg.mixture_eval = opt.eval;
+    merton::OnlineMertonCalibrator cal(merton::MertonParams{}, cfg);
+
+    const std::size_t n = ticks.size();
+    LatencySamples update_tick("update_tick", n);
+    LatencySamples maybe_idle("maybe_update_params (no update)", n);
+    LatencySamples maybe_updated("maybe_update_params (updated)");
+    LatencySamples fair_value("fair_value", n / opt.fv_every + 1);
+    LatencySamples fair_value_ql("fair_value_quantlib", n / opt.fv_every + 1);
+    LatencySamples params("params", n);
+
+    const double q_annual = 0.10;
+    const double t_years = 8.0 / 8766.0;  // one funding interval
+    std::size_t updates = 0;
+    double sink = 0.0;
+
+    const auto start = Clock::now();
+    const std::int64_t first_ts = ticks.front().epoch_us;
+    for (std::size_t i = 0; i < n; ++i) {
+        const merton::TickRecord& tick = ticks[i];
+        if (opt.speed > 0.0) {
+            const auto due = start + std::chrono::microseconds(static_cast<std::int64_t>(
+                                         static_cast<double>(tick.epoch_us - first_ts) / opt.speed));
+            std::this_thread::sleep_until(due);
+        }
+
+        auto t0 = Clock::now();
+        cal.update_tick(tick.price, tick.epoch_us);
+        auto t1 = Clock::now();
+        update_tick.add(t1 - t0);
+
+        t0 = Clock::now();
+        const bool updated = cal.maybe_update_params();
+        t1 = Clock::now();
+        (updated ? maybe_updated : maybe_idle).add(t1 - t0);
+        updates += updated ? 1 : 0;
+
+        t0 = Clock::now();
+        sink += cal.params().sigma;
+        t1 = Clock::now();
+        params.add(t1 - t0);
+
+        if (i % opt.fv_every == 0) {
+            t0 = Clock::now();
+            sink += cal.fair_value(tick.price, q_annual, t_years);
+            t1 = Clock::now();
+            fair_value.add(t1 - t0);
+
+            t0 = Clock::now();
+            sink += cal.fair_value_quantlib(tick.price, q_annual, t_years);
+            t1 = Clock::now();
+            fair_value_ql.add(t1 - t0);
+        }
+    }
+    const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::printf("%-30s %10s %10s %10s %10s %12s\n", "method", "calls", "p50_ns", "p99_ns", "p99.9_ns", "max_ns");
+    update_tick.print();
+    maybe_idle.print();
+    maybe_updated.print();
+    params.print();
+    fair_value.print();
+    fair_value_ql.print();
+
+    const merton::MertonParams p = cal.params();
+    std::printf("\nticks %zu in %.3f s (%.0f ticks/s), mode %s, optimizer %s, eval %s\n", n, elapsed,
+                static_cast<double>(n) / elapsed, opt.async ? "async" : "sync",
+                optimizer_name(opt.optimizer), eval_name(opt.eval));
+    std::printf("param updates %zu (%.1f /s), params_version %llu\n", updates, static_cast<double>(updates) / elapsed,
+                static_cast<unsigned long long>(cal.params_version()));
+    std::printf("final sigma=%.6g lambda=%.6g mu_j=%.6g delta_j=%.6g (checksum %.3g)\n", p.sigma, p.lambda, p.mu_j,
+                p.delta_j, sink);
+    return 0;
+}
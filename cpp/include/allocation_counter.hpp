@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+
+namespace merton {
+
+// Debug instrumentation (MERTON_COUNT_ALLOCATIONS, on in Debug builds):
+// global operator new is replaced to count allocations made on a thread
+// while it is inside an AllocationScope. The calibrator opens a scope in
+// each public hot-path call (and around worker recalibrations), so a
+// steady-state tick -> recalibrate -> fair value loop should leave
+// allocation_count() unchanged. Without the define the scope is empty and
+// the count stays 0.
+bool allocation_counting_enabled();
+std::uint64_t allocation_count();
+
+#ifdef MERTON_COUNT_ALLOCATIONS
+
+class AllocationScope {
+public:
+    AllocationScope();
+    ~AllocationScope();
+
+    AllocationScope(const AllocationScope&) = delete;
+    AllocationScope& operator=(const AllocationScope&) = delete;
+};
+
+#else
+
+// User-provided constructor / destructor so `AllocationScope scope;` does not
+// trip -Wunused-variable in builds without counting.
+class AllocationScope {
+public:
+    AllocationScope() {}
+    ~AllocationScope() {}
+
+    AllocationScope(const AllocationScope&) = delete;
+    AllocationScope& operator=(const AllocationScope&) = delete;
+};
+
+#endif
+
+}  // namespace merton
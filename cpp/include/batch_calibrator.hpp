@@ -0,0 +1,57 @@
+#pragma once
+
+#include "merton_params.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace merton {
+
+// One offline fit. Flat fields so a series maps row for row onto a NumPy
+// structured array.
+struct BatchFit {
+    std::int64_t start_us = 0;   // tick opening the first fitted return
+    std::int64_t end_us = 0;     // tick closing the last one
+    std::uint64_t returns = 0;   // 0: too few valid returns, params = initial
+    double sigma = 0.0;
+    double lambda = 0.0;
+    double mu_j = 0.0;
+    double delta_j = 0.0;
+    double nll = 0.0;            // at the fitted params
+    std::uint64_t iterations = 0;
+};
+
+struct BatchOptions {
+    std::size_t threads = 0;          // including the caller; 0 = hardware threads
+    std::size_t max_iterations = 100;  // L-BFGS iterations per fit
+    std::size_t window = 0;           // calibrate_rolling: returns per window
+    std::size_t step = 0;             // calibrate_rolling: returns between starts (0 = window)
+};
+
+// Offline MLE over historical ticks, outside any OnlineMertonCalibrator.
+// Returns follow update_tick's validity rules (ticks with price <= 0 are
+// skipped; dt <= 0 or non-finite returns are dropped) but not the tick
+// prefilter. Each fit runs the projected L-BFGS on the clamp box from
+// initial, with the NLL at the median dt of its returns and config's n_max,
+// poisson_tail_eps, mixture_eval and improvement_tol; every other config
+// field is ignored.
+//
+// calibrate_batch fits the whole sample: returns are formed in parallel
+// chunks and every NLL + gradient evaluation is a parallel reduction over
+// chunks of returns (summed in chunk order, so results do not depend on
+// thread timing). Inputs are paired up to the shorter length.
+BatchFit calibrate_batch(std::span<const double> prices, std::span<const std::int64_t> epoch_us,
+                         const MertonParams& initial, const CalibratorConfig& config = {},
+                         const BatchOptions& options = {});
+
+// Rolling series: one fit per window of options.window returns, windows
+// starting every options.step returns, all fitted in parallel (one window
+// per task, each from initial). Empty when window < 2 or fewer returns
+// than one window.
+std::vector<BatchFit> calibrate_rolling(std::span<const double> prices, std::span<const std::int64_t> epoch_us,
+                                        const MertonParams& initial, const CalibratorConfig& config = {},
+                                        const BatchOptions& options = {});
+
+}  // namespace merton
@@ -0,0 +1,225 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+namespace merton {
+
+struct BoxLbfgsOptions {
+    std::size_t max_iterations = 20;
+    std::size_t max_line_search = 12;
+    double f_tol = 1e-6;                 // stop once an iteration gains less than this
+    double pg_tol = 1e-9;                // stop once the projected gradient is this small
+    double initial_step = 0.05;          // max |dx| of the first (steepest-descent) step
+    double armijo = 1e-4;
+};
+
+template <std::size_t N>
+struct BoxLbfgsResult {
+    std::array<double, N> x{};
+    double f = std::numeric_limits<double>::infinity();
+    std::size_t iterations = 0;
+    std::size_t evaluations = 0;
+};
+
+// Projected limited-memory BFGS for small boxed problems (an L-BFGS-B
+// variant without the generalized Cauchy point): variables sitting on a bound
+// with the gradient pointing outward are frozen for the iteration, the
+// two-loop recursion runs on the free subspace, and a backtracking Armijo
+// search is done along the projected path P(x + t*d). Fixed-size storage, no
+// allocation.
+//
+// fg(x, g) must return f(x) and write the gradient into g. Non-finite values
+// are treated as a failed trial point.
+template <std::size_t N, std::size_t M = 5>
+class BoxLbfgs {
+public:
+    using Vec = std::array<double, N>;
+
+    BoxLbfgs(const Vec& lower, const Vec& upper, BoxLbfgsOptions options = {})
+        : lower_(lower), upper_(upper), options_(options) {}
+
+    template <typename FG>
+    BoxLbfgsResult<N> minimize(Vec x, FG&& fg) {
+        history_ = 0;
+        head_ = 0;
+
+        BoxLbfgsResult<N> out;
+        x = project(x);
+        Vec g{};
+        double f = fg(x, g);
+        ++out.evaluations;
+        if (!std::isfinite(f)) {
+            out.x = x;
+            return out;
+        }
+
+        for (; out.iterations < options_.max_iterations; ++out.iterations) {
+            std::array<bool, N> free{};
+            double pg_max = 0.0;
+            for (std::size_t i = 0; i < N; ++i) {
+                free[i] = !((x[i] <= lower_[i] && g[i] > 0.0) || (x[i] >= upper_[i] && g[i] < 0.0));
+                pg_max = std::max(pg_max, std::abs(x[i] - std::clamp(x[i] - g[i], lower_[i], upper_[i])));
+            }
+            if (pg_max < options_.pg_tol) {
+                break;
+            }
+
+            Vec d = direction(g, free);
+            double slope = dot(g, d);
+            if (!(slope < 0.0)) {
+                // Curvature pairs no longer describe a descent direction.
+                history_ = 0;
+                d = direction(g, free);
+                slope = dot(g, d);
+                if (!(slope < 0.0)) {
+                    break;
+                }
+            }
+
+            // Backtracking along the projected path.
+            Vec x_new{};
+            Vec g_new{};
+            double f_new = f;
+            bool accepted = false;
+            double t = 1.0;
+            for (std::size_t ls = 0; ls < options_.max_line_search; ++ls, t *= 0.5) {
+                double decrease = 0.0;
+                for (std::size_t i = 0; i < N; ++i) {
+                    x_new[i] = std::clamp(x[i] + t * d[i], lower_[i], upper_[i]);
+                    decrease += g[i] * (x_new[i] - x[i]);
+                }
+                f_new = fg(x_new, g_new);
+                ++out.evaluations;
+                if (std::isfinite(f_new) && f_new <= f + options_.armijo * decrease) {
+                    accepted = true;
+                    break;
+                }
+            }
+            if (!accepted) {
+                break;
+            }
+
+            Vec s{};
+            Vec y{};
+            for (std::size_t i = 0; i < N; ++i) {
+                s[i] = x_new[i] - x[i];
+                y[i] = g_new[i] - g[i];
+            }
+            const double sy = dot(s, y);
+            if (sy > 1e-12 * dot(y, y)) {
+                s_[head_] = s;
+                y_[head_] = y;
+                rho_[head_] = 1.0 / sy;
+                head_ = (head_ + 1) % M;
+                history_ = std::min(history_ + 1, M);
+            }
+
+            const double gain = f - f_new;
+            x = x_new;
+            g = g_new;
+            f = f_new;
+            if (gain < options_.f_tol) {
+                ++out.iterations;
+                break;
+            }
+        }
+
+        out.x = x;
+        out.f = f;
+        return out;
+    }
+
+private:
+    static double dot(const Vec& a, const Vec& b) {
+        double s = 0.0;
+        for (std::size_t i = 0; i < N; ++i) {
+            s += a[i] * b[i];
+        }
+        return s;
+    }
+
+    Vec project(Vec x) const {
+        for (std::size_t i = 0; i < N; ++i) {
+            x[i] = std::clamp(x[i], lower_[i], upper_[i]);
+        }
+        return x;
+    }
+
+    /// -H*g restricted to the free variables (two-loop recursion).
+    Vec direction(const Vec& g, const std::array<bool, N>& free) const {
+        Vec q{};
+        for (std::size_t i = 0; i < N; ++i) {
+            q[i] = free[i] ? g[i] : 0.0;
+        }
+        if (history_ == 0) {
+            double g_max = 0.0;
+            for (double v : q) {
+                g_max = std::max(g_max, std::abs(v));
+            }
+            const double scale = g_max > 0.0 ? options_.initial_step / g_max : 0.0;
+            for (double& v : q) {
+                v *= -scale;
+            }
+            return q;
+        }
+
+        auto masked_dot = [&](const Vec& a, const Vec& b) {
+            double s = 0.0;
+            for (std::size_t i = 0; i < N; ++i) {
+                if (free[i]) {
+                    s += a[i] * b[i];
+                }
+            }
+            return s;
+        };
+
+        std::array<double, M> alpha{};
+        for (std::size_t k = 0; k < history_; ++k) {
+            const std::size_t j = (head_ + M - 1 - k) % M;
+            alpha[j] = rho_[j] * masked_dot(s_[j], q);
+            for (std::size_t i = 0; i < N; ++i) {
+                if (free[i]) {
+                    q[i] -= alpha[j] * y_[j][i];
+                }
+            }
+        }
+
+        const std::size_t last = (head_ + M - 1) % M;
+        const double yy = masked_dot(y_[last], y_[last]);
+        const double gamma = yy > 0.0 ? masked_dot(s_[last], y_[last]) / yy : 1.0;
+        for (double& v : q) {
+            v *= gamma > 0.0 ? gamma : 1.0;
+        }
+
+        for (std::size_t k = history_; k-- > 0;) {
+            const std::size_t j = (head_ + M - 1 - k) % M;
+            const double beta = rho_[j] * masked_dot(y_[j], q);
+            for (std::size_t i = 0; i < N; ++i) {
+                if (free[i]) {
+                    q[i] += (alpha[j] - beta) * s_[j][i];
+                }
+            }
+        }
+
+        for (double& v : q) {
+            v = -v;
+        }
+        return q;
+    }
+
+    Vec lower_;
+    Vec upper_;
+    BoxLbfgsOptions options_;
+
+    std::array<Vec, M> s_{};
+    std::array<Vec, M> y_{};
+    std::array<double, M> rho_{};
+    std::size_t head_ = 0;
+    std::size_t history_ = 0;
+};
+
+}  // namespace merton
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "merton_online_calibrator.hpp"
+#include "spsc_queue.hpp"
+#include "thread_pool.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <unordered_map>
+
+namespace merton {
+
+struct SymbolStats {
+    std::size_t queue_depth = 0;
+    std::size_t sample_count = 0;
+    std::uint64_t ticks_routed = 0;
+    std::uint64_t ticks_dropped = 0;
+    std::uint64_t returns_accepted = 0;
+    std::uint64_t param_updates = 0;
+    std::uint64_t params_version = 0;
+};
+
+struct PoolStats {
+    std::size_t symbols = 0;
+    std::size_t threads = 0;
+    std::uint64_t ticks_routed = 0;
+    std::uint64_t ticks_dropped = 0;
+    std::uint64_t returns_accepted = 0;
+    std::uint64_t param_updates = 0;
+    std::uint64_t tasks_stolen = 0;
+    double elapsed_seconds = 0.0;
+    double ticks_per_second = 0.0;
+    double param_updates_per_second = 0.0;
+};
+
+// Owns one OnlineMertonCalibrator per symbol and runs their ingestion and
+// recalibration on a shared work-stealing ThreadPool. update_tick only
+// pushes into the symbol's SPSC inbox and schedules a drain task if none is
+// pending; at most one task per symbol runs at a time, so each calibrator is
+// still single-threaded while different symbols use different cores.
+//
+// add_symbol / update_tick must come from one producer thread. params(),
+// fair_value() and the stats getters read published state and are safe to
+// call concurrently with the workers.
+class CalibratorPool {
+public:
+    // threads == 0 uses std::thread::hardware_concurrency().
+    explicit CalibratorPool(CalibratorConfig config = {}, std::size_t threads = 0);
+    ~CalibratorPool();
+
+    CalibratorPool(const CalibratorPool&) = delete;
+    CalibratorPool& operator=(const CalibratorPool&) = delete;
+
+    // Returns false if the symbol already exists.
+    bool add_symbol(const std::string& symbol, MertonParams initial);
+    bool has_symbol(const std::string& symbol) const;
+    std::size_t symbol_count() const { return slots_.size(); }
+
+    // Queues a tick for the symbol. Returns false for unknown symbols or when
+    // the inbox is full (tick dropped).
+    bool update_tick(const std::string& symbol, double price, std::int64_t epoch_us);
+
+    // Blocks until all queued ticks are ingested and recalibrations finished.
+    void flush();
+
+    // Throw std::out_of_range for unknown symbols.
+    MertonParams params(const std::string& symbol) const;
+    std::uint64_t params_version(const std::string& symbol) const;
+    double fair_value(const std::string& symbol, double s0, double q_annual, double t_years, double r = 0.0) const;
+    // OnlineMertonCalibrator::fair_values for one symbol.
+    bool fair_values(const std::string& symbol, std::span<const double> s0, std::span<const double> q_annual,
+                     std::span<const double> t_years, std::span<const double> r, std::span<double> out) const;
+    std::size_t queue_depth(const std::string& symbol) const;
+    SymbolStats symbol_stats(const std::string& symbol) const;
+
+    PoolStats stats() const;
+
+private:
+    struct Tick {
+        double price;
+        std::int64_t epoch_us;
+    };
+
+    struct Slot {
+        Slot(MertonParams initial, const CalibratorConfig& config);
+
+        OnlineMertonCalibrator calibrator;
+        SpscQueue<Tick> inbox;
+        std::atomic<bool> scheduled{false};
+        std::atomic<std::uint64_t> ticks_routed{0};
+        std::atomic<std::uint64_t> ticks_dropped{0};
+        std::atomic<std::uint64_t> returns_accepted{0};
+        std::atomic<std::uint64_t> param_updates{0};
+    };
+
+    const Slot& slot(const std::string& symbol) const;
+    void schedule(Slot& s);
+    void drain(Slot& s);
+
+    CalibratorConfig config_;
+    std::unordered_map<std::string, std::unique_ptr<Slot>> slots_;
+    std::chrono::steady_clock::time_point started_;
+    ThreadPool workers_;  // last member: joined before slots_ are destroyed
+};
+
+}  // namespace merton
@@ -0,0 +1,160 @@
+#pragma once
+
+#include "streaming_median.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace merton {
+
+// Percentiles of one latency histogram (ns, bucket midpoints, i.e. within
+// ~3%).
+struct LatencySummary {
+    std::uint64_t count = 0;
+    double mean_ns = 0.0;
+    std::uint64_t p50_ns = 0;
+    std::uint64_t p99_ns = 0;
+    std::uint64_t p999_ns = 0;
+    std::uint64_t max_ns = 0;
+};
+
+// Point-in-time copy of a calibrator's instrumentation. All zero when the
+// library is built with MERTON_ENABLE_STATS=OFF.
+struct CalibratorStats {
+    bool enabled = false;
+
+    std::uint64_t ticks = 0;
+    std::uint64_t returns_accepted = 0;
+    std::uint64_t rejected_price = 0;        // price <= 0 or NaN
+    std::uint64_t rejected_first_tick = 0;   // no previous price yet
+    std::uint64_t rejected_dt = 0;           // dt_us <= 0
+    std::uint64_t rejected_non_finite = 0;   // log return not finite
+    std::uint64_t rejected_queue_full = 0;   // async queue full, dropped
+
+    std::uint64_t recalibrations = 0;
+    std::uint64_t param_updates = 0;
+    std::uint64_t global_searches = 0;       // multi-start searches triggered by an NLL jump
+    std::uint64_t nll_evaluations = 0;
+    std::uint64_t gradient_evaluations = 0;
+    double last_nll = 0.0;              // after the last recalibration
+    double last_nll_improvement = 0.0;  // NLL(before) - NLL(after), >= 0
+
+    LatencySummary update_tick;    // whole update_tick call
+    LatencySummary recalibration;  // one search (maybe_update_params or worker)
+};
+
+enum class TickRejection { price, first_tick, dt, non_finite, queue_full };
+
+#ifdef MERTON_ENABLE_STATS
+
+// Single-writer log-linear latency histogram: record() is a relaxed
+// load + store per field (no RMW), readers may summarize concurrently.
+class LatencyHistogram {
+public:
+    void record(std::uint64_t ns) {
+        bump(counts_[kBuckets.index(ns)], 1);
+        bump(sum_ns_, ns);
+        if (ns > max_ns_.load(std::memory_order_relaxed)) {
+            max_ns_.store(ns, std::memory_order_relaxed);
+        }
+    }
+
+    LatencySummary summary() const;
+    void reset();
+
+private:
+    static void bump(std::atomic<std::uint64_t>& c, std::uint64_t n) {
+        c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    // 16 sub-buckets per octave up to 2^40 ns (~18 min).
+    static constexpr LogLinearBuckets kBuckets{4, 40};
+
+    std::array<std::atomic<std::uint64_t>, kBuckets.count()> counts_{};
+    std::atomic<std::uint64_t> sum_ns_{0};
+    std::atomic<std::uint64_t> max_ns_{0};
+};
+
+// Counters behind CalibratorStats. Tick counters and update_tick latency are
+// written by the ingestion thread, recalibration fields by whichever thread
+// runs the search; evaluation counters use fetch_add since jacobi rounds
+// evaluate candidates on several threads.
+class StatsRecorder {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    class Timer {
+    public:
+        explicit Timer(LatencyHistogram& h) : hist_(h), start_(Clock::now()) {}
+        Timer(const Timer&) = delete;
+        Timer& operator=(const Timer&) = delete;
+        ~Timer() {
+            hist_.record(static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start_).count()));
+        }
+
+    private:
+        LatencyHistogram& hist_;
+        Clock::time_point start_;
+    };
+
+    Timer time_update_tick() { return Timer(update_tick_); }
+    Timer time_recalibration() { return Timer(recalibration_); }
+
+    void tick() { bump(ticks_); }
+    void accepted() { bump(returns_accepted_); }
+    void rejected(TickRejection why) { bump(rejected_[static_cast<std::size_t>(why)]); }
+    void nll_evaluation() { nll_evaluations_.fetch_add(1, std::memory_order_relaxed); }
+    void gradient_evaluation() { gradient_evaluations_.fetch_add(1, std::memory_order_relaxed); }
+    void recalibrated(double nll_before, double nll_after, bool changed);
+    void global_search() { bump(global_searches_); }
+
+    CalibratorStats snapshot() const;
+    void reset();
+
+private:
+    static void bump(std::atomic<std::uint64_t>& c) {
+        c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    std::atomic<std::uint64_t> ticks_{0};
+    std::atomic<std::uint64_t> returns_accepted_{0};
+    std::array<std::atomic<std::uint64_t>, 5> rejected_{};
+    std::atomic<std::uint64_t> recalibrations_{0};
+    std::atomic<std::uint64_t> param_updates_{0};
+    std::atomic<std::uint64_t> global_searches_{0};
+    std::atomic<std::uint64_t> nll_evaluations_{0};
+    std::atomic<std::uint64_t> gradient_evaluations_{0};
+    std::atomic<double> last_nll_{0.0};
+    std::atomic<double> last_nll_improvement_{0.0};
+    LatencyHistogram update_tick_;
+    LatencyHistogram recalibration_;
+};
+
+#else
+
+// MERTON_ENABLE_STATS=OFF: every hook is an empty inline no-op.
+class StatsRecorder {
+public:
+    struct Timer {};
+
+    Timer time_update_tick() { return {}; }
+    Timer time_recalibration() { return {}; }
+
+    void tick() {}
+    void accepted() {}
+    void rejected(TickRejection) {}
+    void nll_evaluation() {}
+    void gradient_evaluation() {}
+    void recalibrated(double, double, bool) {}
+    void global_search() {}
+
+    CalibratorStats snapshot() const { return {}; }
+    void reset() {}
+};
+
+#endif
+
+}  // namespace merton
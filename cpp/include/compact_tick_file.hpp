@@ -0,0 +1,158 @@
+#pragma once
+
+#include "tick_file.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace merton {
+
+// Compact append-only tick capture format:
+//
+//   header  (64 B)   magic "MRTNTCK1", version, block_ticks, price_scale
+//   block*           CompactBlockHeader + zigzag-varint epoch_us deltas +
+//                    zigzag-varint deltas of llround(price * price_scale),
+//                    padded to 8 bytes
+//   index            CompactBlockIndex per block   } written by close();
+//   trailer (32 B)   CompactTrailer                } rebuilt by scanning
+//                                                    when missing
+//
+// Typical quote streams (tick-grid prices, sub-second spacing) take 3-5
+// bytes per tick against 16 for the raw TickRecord format.
+struct CompactFileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t block_ticks;
+    double price_scale;
+    std::uint64_t reserved[5];
+};
+static_assert(sizeof(CompactFileHeader) == 64);
+
+struct CompactBlockHeader {
+    std::uint32_t count;
+    std::uint32_t ts_bytes;
+    std::uint32_t price_bytes;
+    std::uint32_t reserved;
+    std::int64_t first_epoch_us;
+    std::int64_t first_price;  // scaled
+};
+static_assert(sizeof(CompactBlockHeader) == 32);
+
+struct CompactBlockIndex {
+    std::int64_t first_epoch_us;
+    std::int64_t last_epoch_us;
+    std::uint64_t offset;  // of the CompactBlockHeader
+    std::uint64_t count;
+};
+static_assert(sizeof(CompactBlockIndex) == 32);
+
+struct CompactTrailer {
+    std::uint64_t index_offset;
+    std::uint64_t block_count;
+    std::uint64_t tick_count;
+    char magic[8];
+};
+static_assert(sizeof(CompactTrailer) == 32);
+
+// Buffers one block in memory and writes it when full, so append() is a pair
+// of varint encodes except every block_ticks ticks. Not thread-safe.
+class CompactTickWriter {
+public:
+    CompactTickWriter() = default;
+    ~CompactTickWriter();
+
+    CompactTickWriter(const CompactTickWriter&) = delete;
+    CompactTickWriter& operator=(const CompactTickWriter&) = delete;
+
+    // Creates path, or appends to it when it already holds a compact tick
+    // file with the same price_scale (an unclosed file is recovered up to its
+    // last complete block). Returns false on I/O error or format mismatch.
+    bool open(const std::string& path, double price_scale = 1e8, std::uint32_t block_ticks = 4096);
+    // Writes the pending block, index and trailer. Returns false on I/O error.
+    bool close();
+
+    // Returns false if the file is not open or a block write failed, and
+    // skips the tick (returning false) if its price is not finite or
+    // |price * price_scale| >= 2^62.
+    bool append(double price, std::int64_t epoch_us);
+    // Writes the pending (partial) block so the data survives a crash.
+    bool flush();
+
+    bool is_open() const { return file_ != nullptr; }
+    std::uint64_t tick_count() const { return ticks_ + count_; }
+
+private:
+    bool recover(const std::string& path, double price_scale);
+    void reset_block();
+
+    std::FILE* file_ = nullptr;
+    double price_scale_ = 1e8;
+    std::uint32_t block_ticks_ = 4096;
+    std::uint64_t offset_ = 0;  // end of the last written block
+    std::uint64_t ticks_ = 0;   // ticks in written blocks
+    std::vector<CompactBlockIndex> index_;
+
+    std::vector<std::uint8_t> ts_bytes_;
+    std::vector<std::uint8_t> price_bytes_;
+    std::uint32_t count_ = 0;
+    std::int64_t first_ts_ = 0;
+    std::int64_t first_price_ = 0;
+    std::int64_t last_ts_ = 0;
+    std::int64_t last_price_ = 0;
+};
+
+// Read-only memory mapping of a compact tick file. The block index and the
+// encoded columns are served straight from the mapping; decoding writes
+// into caller-provided storage.
+class CompactTickReader {
+public:
+    CompactTickReader() = default;
+    ~CompactTickReader();
+
+    CompactTickReader(const CompactTickReader&) = delete;
+    CompactTickReader& operator=(const CompactTickReader&) = delete;
+
+    // Returns false (errno set) if the file cannot be mapped or has no valid
+    // header. A missing trailer (writer not closed), or an index whose
+    // entries do not match complete blocks and the trailer's tick count, is
+    // tolerated: the index is rebuilt from the block headers up to the last
+    // complete block.
+    bool open(const std::string& path);
+    void close();
+
+    const CompactFileHeader& header() const { return *reinterpret_cast<const CompactFileHeader*>(base_); }
+    std::span<const CompactBlockIndex> blocks() const { return blocks_; }
+    std::uint64_t tick_count() const { return tick_count_; }
+    // End of the last complete block (where an appending writer resumes).
+    std::uint64_t data_end() const { return data_end_; }
+
+    // Encoded columns of block b (zero-copy views into the mapping).
+    std::span<const std::uint8_t> ts_column(std::size_t b) const;
+    std::span<const std::uint8_t> price_column(std::size_t b) const;
+
+    // Decodes block b into out (out.size() >= blocks()[b].count); returns the
+    // number of ticks written, 0 on a corrupt block.
+    std::size_t decode_block(std::size_t b, std::span<TickRecord> out) const;
+    // Decodes every block, appending to out.
+    bool decode_all(std::vector<TickRecord>& out) const;
+
+private:
+    bool open_index();
+    const CompactBlockHeader& block_header(std::size_t b) const;
+
+    const std::uint8_t* base_ = nullptr;
+    std::size_t bytes_ = 0;
+    std::span<const CompactBlockIndex> blocks_;
+    std::vector<CompactBlockIndex> scanned_;  // index rebuilt when no trailer
+    std::uint64_t tick_count_ = 0;
+    std::uint64_t data_end_ = 0;
+};
+
+// True if path starts with the compact tick file magic.
+bool is_compact_tick_file(const std::string& path);
+
+}  // namespace merton
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "merton_likelihood.hpp"
+#include "merton_params.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+namespace merton {
+
+struct EmOptions {
+    std::size_t max_iterations = 25;
+    double tol = 1e-6;           // stop once an iteration gains less NLL than this
+    std::size_t memory = 4096;   // online mode: effective sample size of the decay
+};
+
+struct EmResult {
+    MertonParams params;
+    double start_nll = std::numeric_limits<double>::infinity();
+    double nll = std::numeric_limits<double>::infinity();
+    std::size_t iterations = 0;  // accepted M-steps
+    std::size_t passes = 0;      // E-step passes over the data
+    EmSufficientStats stats;     // E-step at params
+};
+
+// Expectation-maximization on the Poisson-Gaussian mixture, treating the
+// jump count and the diffusion / jump split of each return as latent (see
+// EmSufficientStats). The M-step is closed form; params are projected onto
+// the [lower, upper] box.
+//
+// Batch mode (fit) runs one E-step pass per iteration. Online mode (observe /
+// online_params) keeps exponentially decayed sufficient statistics updated
+// per return, so an M-step costs O(1) and needs no pass over the window; it is
+// seeded from a batch fit, since from a poor start it moves about one EM
+// iteration per `memory` returns.
+class EmMertonCalibrator {
+public:
+    EmMertonCalibrator(const MertonParams& lower, const MertonParams& upper, EmOptions options = {});
+
+    // e_step(p, stats) must add the sufficient statistics of the data under p
+    // to stats (passed zeroed) and return NLL(p). The first pass scores
+    // start. Each cycle takes two EM steps and a SQUAREM extrapolation along
+    // them, keeping whichever of the extrapolated point and the plain EM step
+    // scores better; at most max_iterations passes, and iteration stops once
+    // a cycle gains less than tol.
+    template <typename EStep>
+    EmResult fit(const MertonParams& start, EStep&& e_step) const {
+        EmResult out;
+        out.params = clamp(start);
+        EmSufficientStats stats;
+        out.start_nll = e_step(out.params, stats);
+        out.nll = out.start_nll;
+        out.passes = 1;
+        while (std::isfinite(out.nll) && out.passes < options_.max_iterations) {
+            const MertonParams p0 = out.params;
+            const MertonParams p1 = m_step(stats, p0);
+            EmSufficientStats stats1;
+            const double nll1 = e_step(p1, stats1);
+            ++out.passes;
+            if (!std::isfinite(nll1) || nll1 >= out.nll) {
+                break;
+            }
+            const double before = out.nll;
+            out.params = p1;
+            out.nll = nll1;
+            stats = stats1;
+            ++out.iterations;
+
+            if (out.passes < options_.max_iterations) {
+                const MertonParams pe = extrapolate(p0, p1, m_step(stats1, p1));
+                EmSufficientStats stats_e;
+                const double nll_e = e_step(pe, stats_e);
+                ++out.passes;
+                if (std::isfinite(nll_e) && nll_e < out.nll) {
+                    out.params = pe;
+                    out.nll = nll_e;
+                    stats = stats_e;
+                }
+            }
+            if (before - out.nll < options_.tol) {
+                break;
+            }
+        }
+        out.stats = stats;
+        return out;
+    }
+
+    // Complete-data maximizer for stats; sigma, lambda and the jump size
+    // fall back to prior's values where stats carry no information.
+    MertonParams m_step(const EmSufficientStats& stats, const MertonParams& prior) const;
+
+    // Online E-step for one return; terms must be built from (p, dt_years).
+    void observe(const MixtureTerms& terms, const MertonParams& p, double r, double dt_years);
+    MertonParams online_params(const MertonParams& prior) const { return m_step(online_, prior); }
+    // Decayed mean of -log f(r) over observed returns, each scored under the
+    // params current when it arrived (0 before the first return).
+    double online_nll_per_return() const;
+    // Replaces the online statistics with a batch E-step (e.g. fit().stats).
+    void seed_online(const EmSufficientStats& stats, double nll);
+    bool online_seeded() const { return seeded_; }
+    void reset_online();
+
+private:
+    MertonParams clamp(const MertonParams& p) const;
+    MertonParams extrapolate(const MertonParams& p0, const MertonParams& p1, const MertonParams& p2) const;
+
+    MertonParams lower_;
+    MertonParams upper_;
+    EmOptions options_;
+    double decay_;
+    EmSufficientStats online_;
+    double online_nll_ = 0.0;
+    bool seeded_ = false;
+};
+
+}  // namespace merton
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "calibrator_pool.hpp"
+#include "merton_option_pricer.hpp"
+#include "merton_online_calibrator.hpp"
+#include "quote_engine.hpp"
+#include "reflection_binding_traits.hpp"
+
+// Compute-heavy calibrator entry points run without the GIL so the rest of
+// the Python process (cron jobs, other symbols, websocket publish) keeps
+// running during a recalibration. fair_value_quantlib stays GIL-bound: it
+// writes QuantLib's global evaluation date. Span-taking batch methods are
+// bound by hand in the module entries (zero-copy ndarray / buffer views), as
+// are snapshot / restore (Python bytes) and the window views (read-only
+// arrays over the calibrator's storage). quantlib_curves is not bound.
+template <>
+struct ReflectedBindingTraits<merton::OnlineMertonCalibrator> {
+    static constexpr auto release_gil = std::to_array<std::string_view>({
+        "update_tick",
+        "update_trade",
+        "maybe_update_params",
+        "save_snapshot",
+        "load_snapshot",
+    });
+    static constexpr auto manual = std::to_array<std::string_view>({
+        "update_ticks",
+        "fair_values",
+        "snapshot",
+        "restore",
+        "quantlib_curves",  // C++ only
+        "window_returns",
+        "window_dt_us",
+        "window_log_likelihood",
+    });
+};
+
+// flush() blocks until the pool workers are idle.
+template <>
+struct ReflectedBindingTraits<merton::CalibratorPool> {
+    static constexpr auto release_gil = std::to_array<std::string_view>({
+        "flush",
+    });
+    static constexpr auto manual = std::to_array<std::string_view>({
+        "fair_values",
+    });
+};
+
+// on_quote can run a sync-mode recalibration, so it drops the GIL like
+// update_tick. calibrator() returns a reference into the engine and is bound
+// by hand with reference_internal.
+template <>
+struct ReflectedBindingTraits<merton::QuoteEngine> {
+    static constexpr auto release_gil = std::to_array<std::string_view>({
+        "on_quote",
+        "on_quote_into",
+    });
+    static constexpr auto manual = std::to_array<std::string_view>({
+        "calibrator",
+    });
+};
+
+// The expiry grid and chain pricing take spans and are bound by hand.
+template <>
+struct ReflectedBindingTraits<merton::MertonOptionPricer> {
+    static constexpr std::array<std::string_view, 0> release_gil{};
+    static constexpr auto manual = std::to_array<std::string_view>({
+        "set_expiries",
+        "price_grid",
+    });
+};
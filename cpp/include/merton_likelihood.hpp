@@ -0,0 +1,104 @@
+#pragma once
+
+#include "merton_params.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace merton {
+
+// Mixture sizes with a compile-time specialized kernel (MertonKernel<NMax> in
+// merton_likelihood.cpp): a fixed term count, so the per-return loop over
+// terms is unrolled. Any other count runs the runtime-count kernel; results
+// are identical either way.
+enum class MixtureKernelWidth : std::uint8_t {
+    runtime = 0,
+    n2 = 2,    // n_max = 2, or adaptive truncation at one jump (the usual tick case)
+    n4 = 4,
+    n8 = 8,
+    n15 = 15,  // default n_max
+};
+
+inline constexpr std::array kMixtureKernelWidths{MixtureKernelWidth::n2, MixtureKernelWidth::n4,
+                                                 MixtureKernelWidth::n8, MixtureKernelWidth::n15};
+
+// Kernel that evaluates a mixture of `count` terms.
+constexpr MixtureKernelWidth mixture_kernel_width(std::size_t count) {
+    for (const MixtureKernelWidth w : kMixtureKernelWidths) {
+        if (static_cast<std::size_t>(w) == count) {
+            return w;
+        }
+    }
+    return MixtureKernelWidth::runtime;
+}
+
+// Per-candidate constants of the truncated Poisson-Gaussian mixture. They
+// depend only on (params, dt), so they are built once per candidate and
+// reused for every return in the window.
+struct MixtureTerms {
+    static constexpr std::size_t kMaxTerms = 64;
+
+    std::size_t count = 0;
+    MixtureKernelWidth width = MixtureKernelWidth::runtime;  // mixture_kernel_width(count)
+    MixtureEval eval = MixtureEval::direct;
+    std::array<double, kMaxTerms> mean{};       // mu_n
+    std::array<double, kMaxTerms> inv_sigma{};  // 1 / sigma_n
+    std::array<double, kMaxTerms> coef{};       // P(N=n) / (sqrt(2pi) * sigma_n)
+    std::array<double, kMaxTerms> jumps{};      // n
+    std::array<double, kMaxTerms> log_coef{};   // log(coef_n), log_sum_exp / fast only
+};
+
+// Jump compensator k = E[J-1] = exp(mu_j + 0.5*delta_j^2) - 1.
+double jump_compensator(double mu_j, double delta_j);
+
+// Builds the first min(n_max, kMaxTerms) mixture terms for (p, dt_years).
+// With tail_eps > 0 the series stops at the first n whose remaining Poisson
+// mass P(N > n) is below tail_eps. Also picks the kernel width, so the
+// dispatch is decided once per candidate rather than per window pass.
+// eval selects the kernels used by mixture_nll / _gradient / _em_stats.
+MixtureTerms make_mixture_terms(const MertonParams& p, double dt_years, std::size_t n_max, double tail_eps = 0.0,
+                                MixtureEval eval = MixtureEval::direct);
+
+// Mixture density f(x), floored at 1e-300 (always the direct sum).
+double mixture_pdf(const MixtureTerms& terms, double x);
+
+// Weighted NLL: -sum_i w_i * log f(x_i). Empty w means unit weights.
+// Dispatches at runtime to AVX-512 / AVX2 / scalar.
+double mixture_nll(const MixtureTerms& terms, std::span<const double> x, std::span<const double> w = {});
+
+// Weighted NLL and its gradient in one pass over x. terms must have been
+// built from (p, dt_years); grad receives dNLL/dparam in the matching field.
+double mixture_nll_gradient(const MixtureTerms& terms, const MertonParams& p, double dt_years,
+                            std::span<const double> x, std::span<const double> w, MertonParams& grad);
+
+// Expected complete-data sufficient statistics of the mixture for EM. Each
+// return x is split into a diffusion part D ~ N(drift, sigma^2*dt) and N
+// jumps summing to J ~ N(N*mu_j, N*delta_j^2); the fields are sums over
+// returns of the posterior expectations given x, weighted by multiplicity.
+struct EmSufficientStats {
+    double weight = 0.0;        // sum w
+    double time = 0.0;          // sum w * dt (years)
+    double jumps = 0.0;         // sum w * E[N]
+    double jump_mass = 0.0;     // sum w * P(N >= 1)
+    double diffusion_sq = 0.0;  // sum w * E[(D - drift)^2] / dt
+    double jump_sum = 0.0;      // sum w * E[J]
+    double jump_sq = 0.0;       // sum w * E[J^2 / N; N >= 1]
+
+    void add(const EmSufficientStats& o);
+    void scale(double s);
+};
+
+// EM E-step in one pass over x: adds the sufficient statistics of (x, w)
+// under (p, dt_years) to stats and returns the weighted NLL of p. terms must
+// have been built from (p, dt_years). Floored densities contribute only to
+// the NLL. Dispatched like mixture_nll.
+double mixture_em_stats(const MixtureTerms& terms, const MertonParams& p, double dt_years,
+                        std::span<const double> x, std::span<const double> w, EmSufficientStats& stats);
+
+// Instruction set used by mixture_nll on this machine ("avx512", "avx2", "scalar").
+std::string_view mixture_kernel_isa();
+
+}  // namespace merton
@@ -1,60 +1,227 @@
 #pragma once
 
+#include "allocation_counter.hpp"
+#include "calibrator_stats.hpp"
+#include "compact_tick_file.hpp"
+#include "em_calibrator.hpp"
+#include "merton_likelihood.hpp"
+#include "merton_params.hpp"
+#include "return_histogram.hpp"
+#include "return_window.hpp"
+#include "seqlock.hpp"
+#include "sgd_calibrator.hpp"
+#include "shared_params.hpp"
+#include "spsc_queue.hpp"
+#include "streaming_median.hpp"
+#include "thread_pool.hpp"
+#include "tick_filter.hpp"
+
+#include <atomic>
 #include <cstdint>
-#include <deque>
+#include <memory>
 #include <optional>
+#include <span>
+#include <string>
+#include <thread>
 #include <vector>
 
 namespace merton {
 
-struct MertonParams {
-    double sigma = 0.44;
-    double lambda = 20.0;
-    double mu_j = 0.003;
-    double delta_j = 0.01;
-};
-
-struct CalibratorConfig {
-    std::size_t window_size = 4096;
-    std::size_t min_points_for_update = 512;
-    std::size_t n_max = 15;
-    std::size_t update_every_n_returns = 128;
-    std::size_t coordinate_steps = 3;
-    double improvement_tol = 1e-6;
-};
+class QuantLibCarryCurves;
 
 class OnlineMertonCalibrator {
 public:
     OnlineMertonCalibrator(MertonParams initial, CalibratorConfig config = {});
+    ~OnlineMertonCalibrator();
 
-    // Feed live prices. Returns true if a return was accepted.
+    OnlineMertonCalibrator(const OnlineMertonCalibrator&) = delete;
+    OnlineMertonCalibrator& operator=(const OnlineMertonCalibrator&) = delete;
+
+    // Feed live prices. Returns true if a return was accepted (in async mode:
+    // queued for the worker; false if the queue is full).
     bool update_tick(double price, std::int64_t epoch_us);
+    // Feed a batch of ticks (e.g. a backfill) with the same rules as
+    // update_tick; optionally recalibrates at the configured cadence.
+    // Returns the number of accepted returns.
+    std::size_t update_ticks(std::span<const double> prices,
+                             std::span<const std::int64_t> epoch_us,
+                             bool run_recalibration = false);
+    // update_tick for a trade print: volume feeds TickBars::volume sampling
+    // (update_tick counts each tick as volume 1).
+    bool update_trade(double price, std::int64_t epoch_us, double volume);
 
-    // Returns true if parameters were updated.
+    // Returns true if parameters were updated. In async mode this never
+    // blocks: it reports whether a new params version was published since
+    // the previous call.
     bool maybe_update_params();
 
     // Compute fair value E[S_T] for horizon T (years).
     double fair_value(double s0, double q_annual, double t_years, double r = 0.0) const;
+    // Batch fair_value: n = longest input, every input holds n values or one
+    // broadcast value (e.g. a horizon ladder for one s0). All n values use
+    // the same params snapshot. Returns false, leaving out untouched, on a
+    // length mismatch or out.size() < n.
+    bool fair_values(std::span<const double> s0, std::span<const double> q_annual, std::span<const double> t_years,
+                     std::span<const double> r, std::span<double> out) const;
     // QuantLib-based helper using discount curves/day count for carry forward.
     double fair_value_quantlib(double s0, double q_annual, double t_years, double r = 0.0) const;
+    // Curves behind fair_value_quantlib, e.g. to link a funding term
+    // structure (C++ only; QuantLib types are not bound).
+    QuantLibCarryCurves& quantlib_curves() const;
+
+    // Latest published params (seqlock snapshot; safe from any thread).
+    MertonParams params() const { return published_.load().params; }
+    // Allocation-free variant: overwrites out (e.g. a long-lived Python
+    // MertonParams) and returns the params_version() it belongs to.
+    std::uint64_t params_into(MertonParams& out) const;
+    // Incremented every time new params are published.
+    std::uint64_t params_version() const { return published_.version(); }
+    std::size_t sample_count() const { return sample_count_.load(std::memory_order_relaxed); }
+    bool is_async() const { return worker_.joinable(); }
+    // Ticks dropped by the prefilter so far (see tick_filter.hpp), by stage;
+    // reset by restore(). Call from the ingestion thread.
+    TickFilterCounts filter_counts() const { return filter_.counts(); }
+    std::uint64_t ticks_filtered() const { return filter_.dropped(); }
+    // Likelihood kernel a window pass at dt_years runs under params() (see
+    // MixtureKernelWidth); follows poisson_tail_eps and n_max.
+    MixtureKernelWidth kernel_width(double dt_years) const;
+
+    // Zero-copy read-only views of the rolling window, oldest return first,
+    // into the calibrator's own storage (see WindowView; owner keeps it alive
+    // across restore()). Call from the ingestion thread. A view is one window
+    // state; in async mode the worker keeps appending, so values read from
+    // it are consistent while window_version() still equals view.version.
+    WindowView<double> window_returns() const;
+    WindowView<std::int64_t> window_dt_us() const;
+    // log f(r_i) of every window return under params() at the median dt of
+    // the window, recomputed on each call into a buffer owned by the
+    // calibrator (no allocation); values[i] pairs with window_returns() of
+    // the same version.
+    WindowView<double> window_log_likelihood();
+    // +2 per window change, odd while one is in flight (see ReturnWindow).
+    std::uint64_t window_version() const { return window_.version(); }
+
+    // Hot-path counters and latency percentiles (relaxed reads; safe from
+    // any thread). enabled is false when built with MERTON_ENABLE_STATS=OFF.
+    CalibratorStats stats() const { return stats_.snapshot(); }
+    void reset_stats() { stats_.reset(); }
 
-    const MertonParams& params() const { return params_; }
-    std::size_t sample_count() const { return returns_.size(); }
+    // Capture every tick passed to update_tick / update_ticks into a compact
+    // tick file (appended to if it exists). Call from the ingestion thread.
+    // Ticks whose price the file cannot hold (not finite, or |price *
+    // price_scale| >= 2^62) are left out; the calibrator rejects the
+    // non-finite ones anyway.
+    bool start_recording(const std::string& path, double price_scale);
+    // Writes the pending block and index; returns false on I/O error.
+    bool stop_recording();
+    bool is_recording() const { return recorder_ != nullptr; }
+
+    // Publish to other processes: after every accepted tick and every params
+    // update, write params, params_version, their dt estimate and
+    // fair_value(last accepted price, q_annual, horizon_years, r) into the
+    // POSIX shared-memory segment `name` (see shared_params.hpp), read with
+    // SharedParamsReader. Call from the ingestion thread (in async mode new
+    // params go out on the next tick or maybe_update_params()).
+    bool start_publishing(const std::string& name, double q_annual, double horizon_years, double r = 0.0);
+    // Unmaps the segment; it stays readable until remove_shared_params(name).
+    void stop_publishing();
+    bool is_publishing() const { return shared_ != nullptr; }
+
+    // Warm-start state (params, config, window contents, last tick, update
+    // counter) as a versioned, checksummed blob. In async mode the worker is
+    // paused and its queue drained for the copy, so call from the ingestion
+    // thread.
+    std::vector<std::uint8_t> snapshot();
+    // Replaces the whole state, config included, with a snapshot() blob.
+    // Returns false and leaves the calibrator untouched if the blob is
+    // corrupt or from a build with a different CalibratorConfig layout.
+    bool restore(std::span<const std::uint8_t> blob);
+    bool save_snapshot(const std::string& path);
+    bool load_snapshot(const std::string& path);
 
 private:
-    double merton_pdf(double x, const MertonParams& p, double dt_years) const;
+    // Published params plus lambda*k, so fair-value readers skip the exp in
+    // jump_compensator, and the dt estimate at publish time (for
+    // start_publishing); recomputed once per params version.
+    struct PublishedParams {
+        MertonParams params;
+        double jump_drift;
+        double dt_years;
+    };
+
+    struct PendingReturn {
+        double r;
+        std::int64_t dt_us;
+    };
+
+    void publish();
+    void publish_shared();
+    void init_components();
+    void reset_engines();
+    void start_worker();
+    void stop_worker();
+    bool ingest(double price, std::int64_t epoch_us, double volume);
+    std::optional<PendingReturn> accept_tick(double price, std::int64_t epoch_us, double volume = 1.0);
+    // learn = false replays a return into the window without an online_sgd step.
+    void append_return(double r, std::int64_t dt_us, bool learn = true);
+    void sgd_step(double r, double dt_years);
+    bool recalibration_due() const;
+    bool recalibrate();
+    void coordinate_search(MertonParams& best, double& best_nll, double dt);
+    bool gauss_seidel_round(MertonParams& best, double& best_nll, const MertonParams& step, double dt) const;
+    bool jacobi_round(MertonParams& best, double& best_nll, const MertonParams& step, double dt);
+    void lbfgs_search(MertonParams& best, double& best_nll, double dt) const;
+    void em_search(MertonParams& best, double& start_nll, double& best_nll, double dt);
+    bool nll_jumped(double nll, std::size_t added) const;
+    void global_search(MertonParams& best, double& best_nll, double dt);
+    double em_e_step(const MertonParams& p, double dt_years, EmSufficientStats& stats) const;
+    void worker_loop();
+
+    // make_mixture_terms with this calibrator's n_max / tail / eval settings.
+    MixtureTerms mixture_terms(const MertonParams& p, double dt_years) const;
     double neg_log_likelihood(const MertonParams& p, double dt_years) const;
+    double nll_gradient(const MertonParams& p, double dt_years, MertonParams& grad) const;
     MertonParams clamp_params(const MertonParams& p) const;
     double estimate_dt_years() const;
 
     MertonParams params_;
     CalibratorConfig config_;
 
+    TickFilter filter_;  // ingestion thread
     std::optional<double> last_price_;
     std::optional<std::int64_t> last_ts_us_;
-    std::deque<double> returns_;
-    std::deque<std::int64_t> dt_us_;
+    ReturnWindow window_;
+    ReturnHistogram histogram_;                          // median-dt likelihood
+    std::unique_ptr<DtBucketedHistogram> dt_histogram_;  // heterogeneous_dt only
+    StreamingMedian dt_median_;
     std::size_t returns_since_last_update_ = 0;
+    EmMertonCalibrator em_;    // em / online_em optimizers
+    SgdMertonCalibrator sgd_;  // online_sgd optimizer
+
+    std::unique_ptr<ThreadPool> search_pool_;  // jacobi rounds and global search
+    std::vector<MertonParams> global_candidates_;  // sized in init_components
+    std::vector<double> global_nll_;
+    // NLL and window size after the last window pass (0 returns: none yet),
+    // the reference for the global-search trigger.
+    double last_fit_nll_ = 0.0;
+    std::size_t last_fit_returns_ = 0;
+    std::shared_ptr<std::vector<double>> log_likelihood_;  // window_log_likelihood(), ingestion thread
+    std::vector<std::int64_t> dt_scratch_;
+    std::unique_ptr<CompactTickWriter> recorder_;  // ingestion thread only
+    std::unique_ptr<SharedParamsPublisher> shared_;  // ingestion thread only
+    SharedParams shared_record_;                     // carry of start_publishing
+    std::unique_ptr<QuantLibCarryCurves> ql_curves_;
+    mutable StatsRecorder stats_;  // const NLL evaluations count too
+
+    Seqlock<PublishedParams> published_;
+    std::atomic<std::size_t> sample_count_{0};
+
+    // Async mode: hot thread produces into queue_, worker_ owns the window
+    // and the search state above.
+    std::unique_ptr<SpscQueue<PendingReturn>> queue_;
+    std::uint64_t last_polled_version_ = 0;
+    std::atomic<bool> stop_{false};
+    std::thread worker_;
 };
 
 }  // namespace merton
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "merton_params.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace merton {
+
+class OnlineMertonCalibrator;
+
+enum class OptionRight {
+    call,
+    put,
+};
+
+struct OptionPricerConfig {
+    // The Poisson series of each expiry keeps the terms around the mode
+    // until the mass left out is below tail_eps, or max_terms terms (the
+    // series is then truncated; series_terms() == max_terms flags it, e.g.
+    // for lambda T in the hundreds).
+    double tail_eps = 1e-12;
+    std::size_t max_terms = 128;
+};
+
+// European options on a strike / expiry grid under the calibrated Merton
+// params (Merton 1976): a Poisson(lambda' T)-weighted sum of Black-Scholes
+// prices at r_n and sigma_n. The series of every expiry (weights, r_n,
+// sigma_n, truncation point) is rebuilt only when the params version
+// changes, so pricing a chain only evaluates normal CDFs. Not thread-safe;
+// keep one pricer per pricing thread.
+class MertonOptionPricer {
+public:
+    explicit MertonOptionPricer(OptionPricerConfig config = {});
+
+    // Expiry grid (years) with the carry of each expiry; q_annual and r hold
+    // one value per expiry or one broadcast value. Rebuilds the series for
+    // the current params. Returns false, leaving the grid unchanged, on a
+    // length mismatch.
+    bool set_expiries(std::span<const double> t_years, std::span<const double> q_annual, std::span<const double> r);
+    // Rebuilds the series for params unless version is the cached one.
+    // Returns true if it did.
+    bool update_params(const MertonParams& params, std::uint64_t version);
+    // update_params with the calibrator's published params and version.
+    bool update_from(const OnlineMertonCalibrator& calibrator);
+
+    // One option; NaN before the first update_params, for an expiry out of
+    // range, a non-finite expiry or lambda T, or a non-positive s0 / strike.
+    // Expiries <= 0 price at intrinsic value.
+    double price(double s0, double strike, std::size_t expiry, OptionRight right) const;
+    // Every (expiry, strike) pair, row-major by expiry: out[e * strikes.size() + k].
+    // deltas (dV/dS0, same layout) may be empty. Returns false, leaving the
+    // outputs untouched, before the first update_params or if an output is
+    // shorter than the grid.
+    bool price_grid(double s0, std::span<const double> strikes, OptionRight right, std::span<double> prices,
+                    std::span<double> deltas) const;
+
+    std::size_t expiry_count() const { return expiries_.size(); }
+    // Poisson terms kept for an expiry after truncation (0 if out of range).
+    std::size_t series_terms(std::size_t expiry) const;
+    MertonParams params() const { return params_; }
+    std::uint64_t params_version() const { return version_; }
+    OptionPricerConfig config() const { return config_; }
+
+private:
+    struct Expiry {
+        double t_years;
+        double q_annual;
+        double r;
+        std::size_t terms;
+    };
+
+    // One Black-Scholes leg of the series:
+    //   V_n = spot_coef * N(+-d1) - K * strike_coef * N(+-d2)
+    //   d1 = (log(S0 / K) + drift) / sd + sd / 2, d2 = d1 - sd
+    struct Term {
+        double spot_coef;    // P'(n) * exp(-q T)
+        double strike_coef;  // P'(n) * exp(-r_n T)
+        double drift;        // (r_n - q) T
+        double sd;           // sigma_n sqrt(T)
+        double inv_sd;
+    };
+
+    void rebuild();
+    double price_one(double s0, double strike, double log_moneyness, std::size_t expiry, OptionRight right,
+                     double& delta) const;
+
+    OptionPricerConfig config_;
+    MertonParams params_;
+    std::uint64_t version_;
+    bool has_params_;
+    std::vector<Expiry> expiries_;
+    std::vector<Term> terms_;  // config_.max_terms slots per expiry
+};
+
+}  // namespace merton
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace merton {
+
+// Round structure of the coordinate search in maybe_update_params().
+enum class SearchMode {
+    gauss_seidel,  // greedy: each +/- candidate is tried from the latest best
+    jacobi,        // all 8 candidates of a round evaluated in parallel from the
+                   // same point; the best one is taken afterwards
+};
+
+// Optimizer run by maybe_update_params().
+enum class OptimizerMode {
+    coordinate_search,  // fixed-step +/- search (see search_mode)
+    lbfgsb,             // projected L-BFGS on the clamp box, analytic gradient
+    em,                 // batch EM over the window histogram, closed-form M-steps
+    online_em,          // EM sufficient statistics updated per return, O(1) M-step
+    online_sgd,         // one gradient step per return inside update_tick, no window rescans
+};
+
+// How the likelihood kernels evaluate log f(x) (see merton_likelihood.cpp).
+enum class MixtureEval {
+    direct,       // log of sum_n g_n; densities floored at 1e-300 in the far tails
+    log_sum_exp,  // max-shifted sum in log space: exact log f, no floor
+    fast,         // log_sum_exp with short exp / log polynomials (error ~1e-9)
+};
+
+// Bar sampling of the tick prefilter (see tick_filter.hpp).
+enum class TickBars {
+    none,    // every tick
+    time,    // last tick of each bar_size-microsecond bar
+    volume,  // tick completing each bar_size of traded volume (update_tick: 1 per tick)
+};
+
+struct MertonParams {
+    double sigma = 0.44;
+    double lambda = 20.0;
+    double mu_j = 0.003;
+    double delta_j = 0.01;
+};
+
+// Search box shared by clamp_params, the optimizers and calibrate_batch.
+inline constexpr MertonParams kParamLower{0.05, 0.01, -0.5, 0.01};
+inline constexpr MertonParams kParamUpper{3.0, 40.0, 0.5, 1.0};
+
+struct CalibratorConfig {
+    std::size_t window_size = 4096;
+    std::size_t min_points_for_update = 512;
+    std::size_t n_max = 15;
+    // Stop the Poisson series early once its remaining mass is below this
+    // (<= 0 always sums n_max terms).
+    double poisson_tail_eps = 1e-12;
+    MixtureEval mixture_eval = MixtureEval::direct;
+    std::size_t update_every_n_returns = 128;
+    std::size_t coordinate_steps = 3;
+    double improvement_tol = 1e-6;
+    SearchMode search_mode = SearchMode::gauss_seidel;
+    // Threads for jacobi candidate evaluation (0 = min(8, hardware threads)).
+    std::size_t search_threads = 0;
+    OptimizerMode optimizer = OptimizerMode::coordinate_search;
+    // L-BFGS iteration cap per recalibration (each costs >= 1 fused NLL+gradient pass).
+    std::size_t lbfgs_iterations = 15;
+    // EM iteration cap per recalibration (each is one fused E-step pass).
+    std::size_t em_iterations = 25;
+    // online_sgd step size per return, in units of the clamp box width (the
+    // gradient moments forget over ~window_size returns).
+    double sgd_learning_rate = 1e-4;
+    // Multi-start global search: when the window NLL under the current params
+    // has risen by more than global_search_trigger nats per return added
+    // since the last recalibration, score this many Sobol points of the clamp
+    // box in parallel and let the optimizer polish the best one (0 = off).
+    std::size_t global_search_starts = 0;
+    double global_search_trigger = 1.0;
+    // Tick prefilter ahead of return formation (all stages off by default):
+    // bar sampling, then dropping a tick at the same price as the last one
+    // passed on, or less than min_tick_dt_us after it (0 = off).
+    TickBars tick_bars = TickBars::none;
+    double bar_size = 0.0;
+    bool suppress_duplicate_prices = false;
+    std::int64_t min_tick_dt_us = 0;
+    // Log-return resolution of the window histogram used by the NLL
+    // (<= 0 keeps exact returns and only merges identical values).
+    double return_quantum = 1e-9;
+    // Evaluate each return at its own dt (bucketed into 2^dt_bucket_sub_bits
+    // log-spaced buckets per octave, dt_bucket_sub_bits <= 8) instead of at
+    // the window median dt.
+    bool heterogeneous_dt = false;
+    unsigned dt_bucket_sub_bits = 2;
+    // Run recalibration on a background thread: update_tick hands returns
+    // over through an SPSC queue and params are published via a seqlock.
+    bool async_recalibration = false;
+    std::size_t async_queue_capacity = 16384;
+};
+
+}  // namespace merton
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "merton_params.hpp"
+#include "tick_file.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace merton {
+
+struct PathConfig {
+    std::size_t ticks = 200000;
+    std::uint64_t seed = 42;
+    double s0 = 68000.0;
+    std::int64_t start_epoch_us = 1700000000000000;
+    double mean_dt_us = 250000.0;  // exponential inter-arrival times
+    double tick_size = 0.5;        // prices rounded to this grid (<= 0: no rounding)
+};
+
+// Reproducible Merton jump-diffusion tick path: under the risk-neutral zero-
+// rate drift, log S moves by -(0.5*sigma^2 + lambda*k)*dt + sigma*sqrt(dt)*Z
+// plus Poisson(lambda*dt) jumps of N(mu_j, delta_j^2) between ticks.
+std::vector<TickRecord> simulate_merton_path(const MertonParams& params, const PathConfig& config = {});
+
+}  // namespace merton
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <chrono>
+#include <mutex>
+
+#include <ql/handle.hpp>
+#include <ql/quotes/simplequote.hpp>
+#include <ql/shared_ptr.hpp>
+#include <ql/termstructures/yieldtermstructure.hpp>
+#include <ql/time/date.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
+
+namespace merton {
+
+// Persistent r / q discount curves for fair_value_quantlib. By default both
+// are FlatForward curves over SimpleQuote rates: a call with the same r / q
+// costs two discount() lookups, a new rate is a SimpleQuote::setValue, and
+// the curves are only rebuilt when the evaluation date rolls. Either side
+// can be relinked to a real term structure (e.g. a funding curve), in which
+// case its r / q argument is ignored. Internally locked; QuantLib globals
+// (Settings::evaluationDate) are still process-wide.
+class QuantLibCarryCurves {
+public:
+    QuantLibCarryCurves();
+
+    // No-jump forward S0 * Dq(T) / Dr(T) with T rounded to whole days from
+    // today (>= 1); t_out receives the Actual/365F year fraction used.
+    double forward(double s0, double q_annual, double r, double t_years, double& t_out);
+
+    // nullptr relinks back to the flat quote-driven curve.
+    void link_rate_curve(const QuantLib::ext::shared_ptr<QuantLib::YieldTermStructure>& curve);
+    void link_carry_curve(const QuantLib::ext::shared_ptr<QuantLib::YieldTermStructure>& curve);
+
+private:
+    void roll_date();
+
+    std::mutex mutex_;
+    QuantLib::DayCounter day_counter_ = QuantLib::Actual365Fixed();
+    QuantLib::Date today_;
+    std::chrono::steady_clock::time_point next_date_check_{};
+
+    QuantLib::ext::shared_ptr<QuantLib::SimpleQuote> r_quote_;
+    QuantLib::ext::shared_ptr<QuantLib::SimpleQuote> q_quote_;
+    QuantLib::ext::shared_ptr<QuantLib::YieldTermStructure> r_linked_;  // user curve, or null
+    QuantLib::ext::shared_ptr<QuantLib::YieldTermStructure> q_linked_;
+    QuantLib::RelinkableHandle<QuantLib::YieldTermStructure> r_curve_;
+    QuantLib::RelinkableHandle<QuantLib::YieldTermStructure> q_curve_;
+};
+
+}  // namespace merton
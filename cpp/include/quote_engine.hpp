@@ -0,0 +1,64 @@
+#pragma once
+
+#include "merton_online_calibrator.hpp"
+#include "merton_params.hpp"
+
+#include <cstdint>
+
+namespace merton {
+
+struct QuoteEngineConfig {
+    // Quote half-spread floor around theo; the market half-spread is used
+    // when wider.
+    double min_half_spread_bps = 2.0;
+    // Funding rates arrive per funding interval and are annualized as
+    // rate * (365.25 * 24 / funding_interval_hours).
+    double funding_interval_hours = 8.0;
+    // Fair-value horizon (default: one 8h funding window) and rate r.
+    double horizon_years = 8.0 / (365.25 * 24.0);
+    double rate = 0.0;
+};
+
+// Everything the strategy needs from one quote update.
+struct QuoteResult {
+    bool valid = false;           // bid and ask were positive; otherwise nothing else is set
+    bool tick_accepted = false;   // mid formed a return (see update_tick)
+    bool params_updated = false;  // new params since the previous quote
+    std::uint64_t params_version = 0;
+    double mid = 0.0;
+    double theo = 0.0;
+    double diff_bps = 0.0;  // (theo - mid) / mid in bps
+    double quote_bid = 0.0;
+    double quote_ask = 0.0;
+};
+
+// Per-quote path of the market-making strategy in one call: mid from the
+// top of book, update_tick + maybe_update_params on the owned calibrator,
+// fair value at the annualized funding rate, and a two-sided quote
+// theo -/+ max(theo * min_half_spread_bps, market half-spread).
+// Call from one thread (the calibrator's ingestion thread).
+class QuoteEngine {
+public:
+    QuoteEngine(MertonParams initial, CalibratorConfig calibrator_config = {}, QuoteEngineConfig config = {});
+
+    QuoteResult on_quote(double bid, double ask, std::int64_t epoch_us, double funding_rate);
+    // Allocation-free variant: overwrites out (e.g. a long-lived Python
+    // QuoteResult) and returns out.valid.
+    bool on_quote_into(double bid, double ask, std::int64_t epoch_us, double funding_rate, QuoteResult& out);
+
+    // rate * periods per year for the configured funding interval.
+    double funding_annual(double funding_rate) const { return funding_rate * funding_periods_per_year_; }
+
+    QuoteEngineConfig config() const { return config_; }
+    // The underlying calibrator (params, stats, snapshots, ...).
+    OnlineMertonCalibrator& calibrator() { return calibrator_; }
+
+private:
+    OnlineMertonCalibrator calibrator_;
+    QuoteEngineConfig config_;
+    double funding_periods_per_year_;
+    double min_half_spread_;  // fraction of theo
+    std::uint64_t last_version_;
+};
+
+}  // namespace merton
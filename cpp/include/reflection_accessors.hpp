@@ -1,6 +1,7 @@
 #pragma once
 
 #include <meta>
+#include <type_traits>
 
 // Named accessor to avoid lambda mangling crashes (reflection / expansion).
 template <typename T, std::meta::info M>
@@ -9,3 +10,19 @@ struct Accessor {
     static FieldType get(const T& self) { return self.[:M:]; }
     static void set(T& self, FieldType v) { self.[:M:] = v; }
 };
+
+// NumPy array-protocol type code of an arithmetic field (native byte order),
+// for structured-array columns built from a reflected struct.
+template <typename F>
+consteval const char* numpy_type_code() {
+    static_assert(std::is_arithmetic_v<F>, "structured-array fields must be arithmetic");
+    if constexpr (std::is_same_v<F, bool>) {
+        return "?";
+    } else if constexpr (std::is_floating_point_v<F>) {
+        return sizeof(F) == 8 ? "=f8" : "=f4";
+    } else if constexpr (std::is_signed_v<F>) {
+        return sizeof(F) == 8 ? "=i8" : sizeof(F) == 4 ? "=i4" : sizeof(F) == 2 ? "=i2" : "=i1";
+    } else {
+        return sizeof(F) == 8 ? "=u8" : sizeof(F) == 4 ? "=u4" : sizeof(F) == 2 ? "=u2" : "=u1";
+    }
+}
@@ -1,8 +1,12 @@
 #pragma once
 
 #include "reflection_accessors.hpp"
+#include "reflection_binding_traits.hpp"
 #include <nanobind/nanobind.h>
 #include <nanobind/stl/string.h>
+#include <cstdint>
+#include <cstring>
+#include <span>
 #include <string>
 #include <string_view>
 
@@ -63,7 +67,15 @@ void bind_reflected_member_functions(nb::class_<T>& cl) {
         ) {
             if constexpr (std::meta::has_identifier(m)) {
                 constexpr auto fnName = std::meta::identifier_of(m);
-                if constexpr (std::meta::is_static_member(m)) {
+                if constexpr (reflected_is_manual<T>(fnName)) {
+                    // Bound by hand in the module entry.
+                } else if constexpr (reflected_releases_gil<T>(fnName)) {
+                    if constexpr (std::meta::is_static_member(m)) {
+                        cl.def_static(fnName.data(), &[:m:], nb::call_guard<nb::gil_scoped_release>());
+                    } else {
+                        cl.def(fnName.data(), &[:m:], nb::call_guard<nb::gil_scoped_release>());
+                    }
+                } else if constexpr (std::meta::is_static_member(m)) {
                     cl.def_static(fnName.data(), &[:m:]);
                 } else {
                     cl.def(fnName.data(), &[:m:]);
@@ -72,3 +84,45 @@ void bind_reflected_member_functions(nb::class_<T>& cl) {
         }
     }
 }
+
+template <typename E, typename Scope>
+void bind_reflected_enum(Scope& scope) {
+    constexpr auto enumerators = std::define_static_array(std::meta::enumerators_of(^^E));
+
+    nb::enum_<E> en(scope, std::meta::identifier_of(^^E).data());
+    template for (constexpr auto e : enumerators) {
+        en.value(std::meta::identifier_of(e).data(), [:e:]);
+    }
+}
+
+// Rows of a flat reflected struct as a NumPy structured array: one field per
+// data member, at its C++ offset, so the rows are copied in with one memcpy.
+// nanobind has no structured dtypes, so the array is allocated by numpy.
+template <typename T>
+nb::object reflected_structured_array(std::span<const T> rows) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    constexpr auto members = std::define_static_array(
+        std::meta::nonstatic_data_members_of(^^T, std::meta::access_context::current()));
+
+    nb::list names;
+    nb::list formats;
+    nb::list offsets;
+    template for (constexpr auto m : members) {
+        names.append(std::meta::identifier_of(m).data());
+        formats.append(numpy_type_code<typename Accessor<T, m>::FieldType>());
+        offsets.append(std::meta::offset_of(m).bytes);
+    }
+    nb::dict spec;
+    spec["names"] = names;
+    spec["formats"] = formats;
+    spec["offsets"] = offsets;
+    spec["itemsize"] = sizeof(T);
+
+    const nb::module_ np = nb::module_::import_("numpy");
+    nb::object out = np.attr("empty")(rows.size(), np.attr("dtype")(spec));
+    if (!rows.empty()) {
+        const auto addr = nb::cast<std::uintptr_t>(out.attr("ctypes").attr("data"));
+        std::memcpy(reinterpret_cast<void*>(addr), rows.data(), rows.size_bytes());
+    }
+    return out;
+}
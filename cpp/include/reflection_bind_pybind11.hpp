@@ -1,7 +1,11 @@
 #pragma once
 
 #include "reflection_accessors.hpp"
+#include "reflection_binding_traits.hpp"
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
+#include <cstring>
+#include <span>
 #include <string>
 #include <string_view>
 
@@ -59,7 +63,15 @@ void bind_reflected_member_functions(py::class_<T>& cl) {
         ) {
             if constexpr (std::meta::has_identifier(m)) {
                 constexpr auto fnName = std::meta::identifier_of(m);
-                if constexpr (std::meta::is_static_member(m)) {
+                if constexpr (reflected_is_manual<T>(fnName)) {
+                    // Bound by hand in the module entry.
+                } else if constexpr (reflected_releases_gil<T>(fnName)) {
+                    if constexpr (std::meta::is_static_member(m)) {
+                        cl.def_static(fnName.data(), &[:m:], py::call_guard<py::gil_scoped_release>());
+                    } else {
+                        cl.def(fnName.data(), &[:m:], py::call_guard<py::gil_scoped_release>());
+                    }
+                } else if constexpr (std::meta::is_static_member(m)) {
                     cl.def_static(fnName.data(), &[:m:]);
                 } else {
                     cl.def(fnName.data(), &[:m:]);
@@ -68,3 +80,42 @@ void bind_reflected_member_functions(py::class_<T>& cl) {
         }
     }
 }
+
+template <typename E, typename Scope>
+void bind_reflected_enum(Scope& scope) {
+    constexpr auto enumerators = std::define_static_array(std::meta::enumerators_of(^^E));
+
+    py::enum_<E> en(scope, std::meta::identifier_of(^^E).data());
+    template for (constexpr auto e : enumerators) {
+        en.value(std::meta::identifier_of(e).data(), [:e:]);
+    }
+}
+
+// Rows of a flat reflected struct as a NumPy structured array: one field per
+// data member, at its C++ offset, so the rows are copied in with one memcpy.
+template <typename T>
+py::array reflected_structured_array(std::span<const T> rows) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    constexpr auto members = std::define_static_array(
+        std::meta::nonstatic_data_members_of(^^T, std::meta::access_context::current()));
+
+    py::list names;
+    py::list formats;
+    py::list offsets;
+    template for (constexpr auto m : members) {
+        names.append(std::meta::identifier_of(m).data());
+        formats.append(numpy_type_code<typename Accessor<T, m>::FieldType>());
+        offsets.append(std::meta::offset_of(m).bytes);
+    }
+    py::dict spec;
+    spec["names"] = names;
+    spec["formats"] = formats;
+    spec["offsets"] = offsets;
+    spec["itemsize"] = sizeof(T);
+
+    py::array out(py::dtype::from_args(spec), {static_cast<py::ssize_t>(rows.size())});
+    if (!rows.empty()) {
+        std::memcpy(out.mutable_data(), rows.data(), rows.size_bytes());
+    }
+    return out;
+}
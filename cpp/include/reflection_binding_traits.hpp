@@ -0,0 +1,31 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <string_view>
+
+// Per-class binding policy consumed by bind_reflected_member_functions in
+// both backends. Specialize for a bound class to tag methods by name; the
+// binder looks names up at compile time while walking members_of(^^T).
+template <typename T>
+struct ReflectedBindingTraits {
+    // Methods bound with the GIL released. They must not touch Python
+    // objects, and the instance must still be driven from one thread.
+    static constexpr std::array<std::string_view, 0> release_gil{};
+    // Methods skipped by the reflected binder because their signatures need
+    // backend-specific conversion (e.g. std::span <-> ndarray); the module
+    // entry binds them by hand.
+    static constexpr std::array<std::string_view, 0> manual{};
+};
+
+template <typename T>
+consteval bool reflected_releases_gil(std::string_view name) {
+    constexpr auto& names = ReflectedBindingTraits<T>::release_gil;
+    return std::find(names.begin(), names.end(), name) != names.end();
+}
+
+template <typename T>
+consteval bool reflected_is_manual(std::string_view name) {
+    constexpr auto& names = ReflectedBindingTraits<T>::manual;
+    return std::find(names.begin(), names.end(), name) != names.end();
+}
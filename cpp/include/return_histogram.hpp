@@ -0,0 +1,85 @@
+#pragma once
+
+#include "streaming_median.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace merton {
+
+// Compact sufficient statistic for the rolling window: the multiset of
+// (quantized) log returns as distinct values plus multiplicities. Returns in
+// the window are treated as i.i.d., so the NLL only depends on this multiset
+// and a candidate evaluation costs O(distinct values) instead of O(window).
+//
+// quantum > 0 rounds returns to the nearest multiple of quantum; quantum <= 0
+// only merges bit-identical returns (exact likelihood).
+class ReturnHistogram {
+public:
+    ReturnHistogram(double quantum, std::size_t capacity);
+
+    void add(double r);
+    // Removes one occurrence of r (must have been added before).
+    void remove(double r);
+    void clear();
+
+    std::size_t distinct() const { return keys_.size(); }
+    std::size_t total() const { return total_; }
+
+    // Parallel arrays (same length as distinct()) for the likelihood kernels.
+    const std::vector<double>& values() const { return values_; }
+    const std::vector<double>& counts() const { return counts_; }
+
+private:
+    std::int64_t key_of(double r) const;
+    double value_of(std::int64_t key, double r) const;
+
+    double quantum_;
+    std::vector<std::int64_t> keys_;  // sorted
+    std::vector<double> values_;
+    std::vector<double> counts_;
+    std::size_t total_ = 0;
+};
+
+// Largest DtBucketedHistogram sub_bits (2^8 buckets per octave, ~0.4%
+// relative width); finer layouts only add empty buckets.
+inline constexpr unsigned kMaxDtBucketSubBits = 8;
+
+// ReturnHistogram per log-spaced dt bucket (LogLinearBuckets over dt_us,
+// 2^sub_bits buckets per octave), for likelihoods where each return is
+// evaluated at its own time step. Per-bucket histograms start empty and grow
+// on demand, so memory follows the dts actually seen.
+class DtBucketedHistogram {
+public:
+    // sub_bits is clamped to kMaxDtBucketSubBits (and max_bits).
+    DtBucketedHistogram(double quantum, unsigned sub_bits, unsigned max_bits = 40);
+
+    void add(double r, std::int64_t dt_us);
+    // Removes one occurrence of (r, dt_us) (must have been added before).
+    void remove(double r, std::int64_t dt_us);
+    void clear();
+
+    std::size_t total() const { return total_; }
+    std::size_t active_buckets() const;
+
+    // f(dt_us, histogram) for every non-empty bucket; dt_us is the bucket
+    // midpoint.
+    template <typename F>
+    void for_each_bucket(F&& f) const {
+        for (std::size_t i = 0; i < buckets_.size(); ++i) {
+            if (buckets_[i].total() > 0) {
+                f(static_cast<double>(layout_.representative(i)), buckets_[i]);
+            }
+        }
+    }
+
+private:
+    std::size_t bucket_of(std::int64_t dt_us) const;
+
+    LogLinearBuckets layout_;
+    std::vector<ReturnHistogram> buckets_;
+    std::size_t total_ = 0;
+};
+
+}  // namespace merton
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace merton {
+
+// Relaxed atomic load of a value another thread may be writing through
+// store_relaxed (std::atomic_ref needs a non-const referent; the objects
+// themselves are never const).
+template <typename T>
+T load_relaxed(const T& v) {
+    return std::atomic_ref<T>(const_cast<T&>(v)).load(std::memory_order_relaxed);
+}
+
+template <typename T>
+void store_relaxed(T& v, T value) {
+    std::atomic_ref<T>(v).store(value, std::memory_order_relaxed);
+}
+
+// Read-only view of one window column in FIFO order (oldest first). owner
+// keeps the storage alive, so the span stays dereferenceable for as long as
+// the view is held; version is the ReturnWindow::version() it was taken at.
+template <typename T>
+struct WindowView {
+    std::span<const T> values;
+    std::shared_ptr<const void> owner;
+    std::uint64_t version = 0;
+};
+
+// Fixed-capacity rolling window of (log return, dt_us) stored as two
+// parallel columns in one power-of-two ring. All storage is allocated in the
+// constructor; push/pop never allocate and cost O(1).
+//
+// Every slot is mirrored one ring length further on, so the contents are
+// always one contiguous range [head, head + size) of each column and can be
+// handed out as zero-copy views. One thread mutates the window. Each
+// mutation moves version() by 2 (odd while in progress) and writes through
+// relaxed atomics, so other threads may read it seqlock-style: views()
+// returns spans of one state, and values read from them belong to that
+// state if version() still matches afterwards.
+class ReturnWindow {
+public:
+    struct Views {
+        std::span<const double> returns;
+        std::span<const std::int64_t> dt_us;
+        std::uint64_t version;
+    };
+
+    explicit ReturnWindow(std::size_t capacity) { allocate(capacity); }
+
+    std::size_t size() const { return size_; }
+    std::size_t capacity() const { return capacity_; }
+    bool empty() const { return size_ == 0; }
+    bool full() const { return size_ >= capacity_; }
+
+    // Oldest sample; window must be non-empty.
+    double front_return() const { return returns_[head_]; }
+    std::int64_t front_dt_us() const { return dt_us_[head_]; }
+
+    // i-th sample in FIFO order (0 = oldest).
+    double return_at(std::size_t i) const { return returns_[head_ + i]; }
+    std::int64_t dt_us_at(std::size_t i) const { return dt_us_[head_ + i]; }
+
+    // Appends a sample; caller evicts with pop_front() first when full().
+    void push_back(double r, std::int64_t dt_us) {
+        const std::uint64_t seq = begin_write();
+        const std::size_t tail = (head_ + size_) & mask_;
+        store_relaxed(returns_[tail], r);
+        store_relaxed(returns_[tail + mask_ + 1], r);
+        store_relaxed(dt_us_[tail], dt_us);
+        store_relaxed(dt_us_[tail + mask_ + 1], dt_us);
+        store_relaxed(size_, size_ + 1);
+        end_write(seq);
+    }
+
+    void pop_front() {
+        const std::uint64_t seq = begin_write();
+        store_relaxed(head_, (head_ + 1) & mask_);
+        store_relaxed(size_, size_ - 1);
+        end_write(seq);
+    }
+
+    void clear() {
+        const std::uint64_t seq = begin_write();
+        store_relaxed(head_, std::size_t{0});
+        store_relaxed(size_, std::size_t{0});
+        end_write(seq);
+    }
+
+    // Empties the window with fresh storage for capacity. Views handed out
+    // earlier keep the old storage alive; version() keeps counting up.
+    void reset(std::size_t capacity) {
+        const std::uint64_t seq = begin_write();
+        allocate(capacity);
+        end_write(seq);
+    }
+
+    // Owner thread: current contents.
+    std::span<const double> returns() const { return {returns_ + head_, size_}; }
+    std::span<const std::int64_t> dt_us() const { return {dt_us_ + head_, size_}; }
+
+    // Any thread: spans of one window state (retries while a mutation is in
+    // flight) and the even version() they belong to.
+    Views views() const {
+        for (;;) {
+            const std::uint64_t before = seq_.load(std::memory_order_acquire);
+            if (before & 1) {
+                continue;
+            }
+            const std::size_t head = load_relaxed(head_);
+            const std::size_t size = load_relaxed(size_);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq_.load(std::memory_order_relaxed) == before) {
+                return {{returns_ + head, size}, {dt_us_ + head, size}, before};
+            }
+        }
+    }
+
+    // Even while no mutation is in flight; +2 per push / pop / clear / reset.
+    std::uint64_t version() const { return seq_.load(std::memory_order_acquire); }
+    // True if version() still equals one taken earlier, i.e. values read
+    // (relaxed) from that version's views in between are consistent.
+    bool unchanged_since(std::uint64_t version) const {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return seq_.load(std::memory_order_relaxed) == version;
+    }
+    // Keeps the column storage alive for views.
+    std::shared_ptr<const void> storage() const { return columns_; }
+
+private:
+    struct Columns {
+        std::vector<double> returns;
+        std::vector<std::int64_t> dt_us;
+    };
+
+    void allocate(std::size_t capacity) {
+        capacity_ = capacity;
+        mask_ = std::bit_ceil(capacity > 0 ? capacity : std::size_t{1}) - 1;
+        auto columns = std::make_shared<Columns>();
+        columns->returns.resize(2 * (mask_ + 1));
+        columns->dt_us.resize(2 * (mask_ + 1));
+        returns_ = columns->returns.data();
+        dt_us_ = columns->dt_us.data();
+        columns_ = std::move(columns);
+        head_ = 0;
+        size_ = 0;
+    }
+
+    std::uint64_t begin_write() {
+        const std::uint64_t seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        return seq;
+    }
+
+    void end_write(std::uint64_t seq) { seq_.store(seq + 2, std::memory_order_release); }
+
+    std::size_t capacity_ = 0;
+    std::size_t mask_ = 0;
+    std::shared_ptr<Columns> columns_;
+    double* returns_ = nullptr;  // columns_->returns.data()
+    std::int64_t* dt_us_ = nullptr;
+    std::size_t head_ = 0;
+    std::size_t size_ = 0;
+    std::atomic<std::uint64_t> seq_{0};
+};
+
+}  // namespace merton
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace merton {
+
+// Single-writer / multi-reader sequence lock for small trivially copyable
+// values. Readers never block the writer and retry only if they overlap a
+// store. The payload is kept in relaxed atomic words so concurrent access is
+// race-free under the C++ memory model.
+template <typename T>
+class Seqlock {
+    static_assert(std::is_trivially_copyable_v<T>, "Seqlock payload must be trivially copyable");
+
+public:
+    Seqlock() = default;
+    explicit Seqlock(const T& initial) { store(initial); }
+
+    // Writer side (one thread at a time).
+    void store(const T& value) {
+        std::uint64_t words[kWords] = {};
+        std::memcpy(words, &value, sizeof(T));
+        const std::uint64_t seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i = 0; i < kWords; ++i) {
+            data_[i].store(words[i], std::memory_order_relaxed);
+        }
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    // Reader side (any thread, wait-free unless a store is in flight).
+    T load() const {
+        std::uint64_t version = 0;
+        return load(version);
+    }
+
+    // Same, also reporting which version() the value belongs to.
+    T load(std::uint64_t& version) const {
+        std::uint64_t words[kWords];
+        for (;;) {
+            const std::uint64_t before = seq_.load(std::memory_order_acquire);
+            if (before & 1) {
+                continue;
+            }
+            for (std::size_t i = 0; i < kWords; ++i) {
+                words[i] = data_[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq_.load(std::memory_order_relaxed) == before) {
+                version = before / 2;
+                break;
+            }
+        }
+        T value;
+        std::memcpy(&value, words, sizeof(T));
+        return value;
+    }
+
+    // Number of completed stores.
+    std::uint64_t version() const { return seq_.load(std::memory_order_acquire) / 2; }
+
+private:
+    static constexpr std::size_t kWords = (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+    std::atomic<std::uint64_t> seq_{0};
+    std::atomic<std::uint64_t> data_[kWords] = {};
+};
+
+}  // namespace merton
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "merton_params.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace merton {
+
+struct SgdOptions {
+    double learning_rate = 1e-4;  // largest step per return, in units of the box width
+    std::size_t memory = 4096;    // effective sample size of the gradient second moment
+    double momentum = 0.9;        // first-moment decay
+};
+
+// Streaming gradient descent on the per-return NLL with exponential
+// forgetting: each return moves the params once along an exponentially
+// weighted average of recent per-return gradients (Adam-style first and
+// second moments, in box-normalized coordinates so one learning rate suits
+// all four parameters). With a constant step, a return's influence on the
+// params decays geometrically as later returns arrive, so the estimate
+// tracks an exponentially weighted likelihood rather than a hard window.
+// O(1) per return; only the moments are kept.
+class SgdMertonCalibrator {
+public:
+    SgdMertonCalibrator(const MertonParams& lower, const MertonParams& upper, SgdOptions options = {});
+
+    // p after one step along grad (dNLL/dparam of the latest return); not
+    // clamped, the caller projects onto its box.
+    MertonParams step(const MertonParams& p, const MertonParams& grad);
+    std::uint64_t steps() const { return steps_; }
+    void reset();
+
+private:
+    std::array<double, 4> span_;
+    SgdOptions options_;
+    double second_decay_;
+    std::array<double, 4> m_{};
+    std::array<double, 4> v_{};
+    double m_scale_ = 1.0;  // momentum^steps, for the bias correction
+    double v_scale_ = 1.0;  // second_decay^steps
+    std::uint64_t steps_ = 0;
+};
+
+}  // namespace merton
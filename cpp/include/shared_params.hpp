@@ -0,0 +1,81 @@
+#pragma once
+
+#include "merton_params.hpp"
+
+#include <cstdint>
+#include <string>
+
+namespace merton {
+
+// Calibrator state published across processes (see
+// OnlineMertonCalibrator::start_publishing). Trivially copyable: it is the
+// payload of a Seqlock in the shared segment.
+struct SharedParams {
+    MertonParams params;
+    std::uint64_t params_version = 0;  // OnlineMertonCalibrator::params_version()
+    double dt_years = 0.0;             // median return interval when params were published
+    double s0 = 0.0;                   // last accepted tick
+    std::int64_t epoch_us = 0;
+    double fair_value = 0.0;           // fair_value(s0, q_annual, horizon_years, r)
+    double q_annual = 0.0;
+    double horizon_years = 0.0;
+    double r = 0.0;
+};
+
+// Writer end of a POSIX shared-memory segment holding one
+// Seqlock<SharedParams>. One publisher per segment name; not thread-safe.
+class SharedParamsPublisher {
+public:
+    SharedParamsPublisher() = default;
+    ~SharedParamsPublisher();
+
+    SharedParamsPublisher(const SharedParamsPublisher&) = delete;
+    SharedParamsPublisher& operator=(const SharedParamsPublisher&) = delete;
+
+    // Creates the segment `name` (shm_open name, e.g. "/merton_xbtusd"), or
+    // reuses an existing one with the same layout, so readers that already
+    // mapped it keep receiving across a publisher restart. Returns false on
+    // error or layout mismatch.
+    bool open(const std::string& name);
+    void close();
+    bool is_open() const { return segment_ != nullptr; }
+
+    void store(const SharedParams& value);
+
+private:
+    void* segment_ = nullptr;
+};
+
+// Reader end, for any number of processes. Maps the segment read-only; a
+// read is a seqlock load (wait-free unless it overlaps a store), so polling
+// costs nanoseconds and never blocks the publisher. Reads are safe from any
+// thread.
+class SharedParamsReader {
+public:
+    // is_open() is false if the segment does not exist (yet) or has another
+    // layout; construct a new reader to retry.
+    explicit SharedParamsReader(const std::string& name);
+    ~SharedParamsReader();
+
+    SharedParamsReader(const SharedParamsReader&) = delete;
+    SharedParamsReader& operator=(const SharedParamsReader&) = delete;
+
+    bool is_open() const { return segment_ != nullptr; }
+    // Latest published state (default-constructed if not open).
+    SharedParams read() const;
+    // Allocation-free variant: overwrites out (e.g. a long-lived Python
+    // SharedParams) and returns the sequence() it belongs to (0 if not open).
+    std::uint64_t read_into(SharedParams& out) const;
+    // Number of stores so far; poll it to detect a new record without
+    // copying one.
+    std::uint64_t sequence() const;
+
+private:
+    const void* segment_ = nullptr;
+};
+
+// shm_unlink(name): the segment disappears once every mapping is gone.
+// Returns false if it did not exist.
+bool remove_shared_params(const std::string& name);
+
+}  // namespace merton
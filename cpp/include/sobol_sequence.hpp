@@ -0,0 +1,94 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace merton {
+
+// Sobol low-discrepancy points in [0, 1)^Dims (Gray-code order, Joe & Kuo
+// direction numbers, 32-bit resolution). The first point is the origin;
+// any prefix of 2^k points puts exactly one point in every dyadic box of
+// volume 2^-k, so a few dozen starts already cover a 4-d box evenly. No
+// allocation; next() is one XOR per dimension.
+template <std::size_t Dims>
+class SobolSequence {
+    static_assert(Dims >= 1 && Dims <= 4, "direction numbers are tabulated for up to 4 dimensions");
+
+public:
+    using Point = std::array<double, Dims>;
+
+    SobolSequence() {
+        for (std::size_t d = 0; d < Dims; ++d) {
+            init_directions(d);
+        }
+    }
+
+    Point next() {
+        Point out{};
+        for (std::size_t d = 0; d < Dims; ++d) {
+            out[d] = static_cast<double>(x_[d]) * 0x1p-32;
+        }
+        // Gray code: point i+1 differs from point i in the direction of the
+        // lowest zero bit of i.
+        const int c = std::countr_one(index_);
+        ++index_;
+        if (c < kBits) {
+            for (std::size_t d = 0; d < Dims; ++d) {
+                x_[d] ^= directions_[d][static_cast<std::size_t>(c)];
+            }
+        }
+        return out;
+    }
+
+    void reset() {
+        x_.fill(0);
+        index_ = 0;
+    }
+
+private:
+    static constexpr int kBits = 32;
+
+    // Primitive polynomial degree s, its inner coefficients a and the initial
+    // m_1..m_s of dimensions 2..4 (dimension 1 is van der Corput).
+    struct Primitive {
+        unsigned s;
+        std::uint32_t a;
+        std::array<std::uint32_t, 3> m;
+    };
+    static constexpr std::array<Primitive, 3> kPrimitives{{
+        {1, 0, {1, 0, 0}},
+        {2, 1, {1, 3, 0}},
+        {3, 1, {1, 3, 1}},
+    }};
+
+    void init_directions(std::size_t d) {
+        auto& v = directions_[d];
+        if (d == 0) {
+            for (int k = 0; k < kBits; ++k) {
+                v[static_cast<std::size_t>(k)] = std::uint32_t{1} << (kBits - 1 - k);
+            }
+            return;
+        }
+        const Primitive& p = kPrimitives[d - 1];
+        for (unsigned k = 0; k < p.s; ++k) {
+            v[k] = p.m[k] << (kBits - 1 - static_cast<int>(k));
+        }
+        for (unsigned k = p.s; k < static_cast<unsigned>(kBits); ++k) {
+            std::uint32_t value = v[k - p.s] ^ (v[k - p.s] >> p.s);
+            for (unsigned j = 1; j < p.s; ++j) {
+                if ((p.a >> (p.s - 1 - j)) & 1u) {
+                    value ^= v[k - j];
+                }
+            }
+            v[k] = value;
+        }
+    }
+
+    std::array<std::array<std::uint32_t, kBits>, Dims> directions_{};
+    std::array<std::uint32_t, Dims> x_{};
+    std::uint32_t index_ = 0;
+};
+
+}  // namespace merton
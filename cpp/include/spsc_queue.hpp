@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace merton {
+
+// Bounded lock-free single-producer / single-consumer ring. Capacity is
+// rounded up to a power of two; storage is allocated once.
+template <typename T>
+class SpscQueue {
+public:
+    explicit SpscQueue(std::size_t capacity)
+        : mask_(std::bit_ceil(capacity > 1 ? capacity : std::size_t{2}) - 1),
+          slots_(mask_ + 1) {}
+
+    std::size_t capacity() const { return mask_ + 1; }
+
+    // Producer side. Returns false when full.
+    bool try_push(const T& v) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_cache_ > mask_) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            if (tail - head_cache_ > mask_) {
+                return false;
+            }
+        }
+        slots_[tail & mask_] = v;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side.
+    std::optional<T> try_pop() {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_cache_) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            if (head == tail_cache_) {
+                return std::nullopt;
+            }
+        }
+        T v = slots_[head & mask_];
+        head_.store(head + 1, std::memory_order_release);
+        return v;
+    }
+
+    // Approximate depth (exact when called from either endpoint thread).
+    std::size_t size() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+private:
+    static constexpr std::size_t kLine = 64;
+
+    const std::size_t mask_;
+    std::vector<T> slots_;
+    alignas(kLine) std::atomic<std::size_t> head_{0};
+    std::size_t tail_cache_ = 0;  // consumer-local
+    alignas(kLine) std::atomic<std::size_t> tail_{0};
+    std::size_t head_cache_ = 0;  // producer-local
+};
+
+}  // namespace merton
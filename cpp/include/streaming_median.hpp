@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace merton {
+
+// HDR-style log-linear bucketing of non-negative integers. With S sub-bucket
+// bits, values below 2^(S+1) get their own bucket; larger values keep the
+// top S+1 significant bits, i.e. relative bucket width <= 2^-S.
+struct LogLinearBuckets {
+    unsigned sub_bits;
+    unsigned max_bits;  // values are clamped to [0, 2^max_bits - 1]
+
+    constexpr std::size_t count() const {
+        return (std::size_t{1} << sub_bits) * (max_bits - sub_bits + 1);
+    }
+
+    constexpr std::size_t index(std::uint64_t v) const {
+        const std::uint64_t sub = std::uint64_t{1} << sub_bits;
+        const std::uint64_t max_v = (std::uint64_t{1} << max_bits) - 1;
+        if (v > max_v) {
+            v = max_v;
+        }
+        if (v < 2 * sub) {
+            return static_cast<std::size_t>(v);
+        }
+        const unsigned shift = static_cast<unsigned>(63 - __builtin_clzll(v)) - sub_bits;
+        return static_cast<std::size_t>(sub * shift + (v >> shift));
+    }
+
+    constexpr std::uint64_t lower_bound(std::size_t idx) const {
+        const std::uint64_t sub = std::uint64_t{1} << sub_bits;
+        if (idx < 2 * sub) {
+            return idx;
+        }
+        const std::uint64_t shift = idx / sub - 1;
+        return (idx - sub * shift) << shift;
+    }
+
+    constexpr std::uint64_t width(std::size_t idx) const {
+        const std::uint64_t sub = std::uint64_t{1} << sub_bits;
+        return idx < 2 * sub ? 1 : std::uint64_t{1} << (idx / sub - 1);
+    }
+
+    // Bucket midpoint (exact for unit-width buckets).
+    constexpr std::uint64_t representative(std::size_t idx) const {
+        return lower_bound(idx) + width(idx) / 2;
+    }
+};
+
+// Rolling median of window dts: counts per log-linear bucket in a Fenwick
+// tree, so add/remove/median are O(log buckets) and never allocate after
+// construction. Exact below 2^(sub_bits+1); above that the median is the
+// bucket midpoint (relative error <= 2^-(sub_bits+1)).
+class StreamingMedian {
+public:
+    explicit StreamingMedian(unsigned sub_bits = 10, unsigned max_bits = 40);
+
+    void add(std::int64_t v);
+    void remove(std::int64_t v);
+    void clear();
+
+    std::size_t size() const { return size_; }
+    // Upper median (element size/2 in sorted order); 0 when empty.
+    std::int64_t median() const;
+
+private:
+    void bump(std::size_t idx, std::int32_t delta);
+    std::size_t kth(std::size_t k) const;
+
+    LogLinearBuckets buckets_;
+    std::vector<std::uint32_t> tree_;  // 1-based Fenwick tree over buckets
+    std::size_t top_bit_ = 0;          // highest power of two <= bucket count
+    std::size_t size_ = 0;
+};
+
+}  // namespace merton
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace merton {
+
+// Fixed-size work-stealing thread pool. Each worker owns a deque (a ring
+// that only grows, so steady-state submits do not allocate): tasks
+// submitted from a worker go to its own deque (LIFO for locality), external
+// submissions are spread round-robin, and idle workers steal the oldest
+// task from their peers so uneven bursts still use every core.
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    // threads == 0 uses std::thread::hardware_concurrency().
+    explicit ThreadPool(std::size_t threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Tasks must not throw.
+    void submit(Task task);
+    // Blocks until every submitted task has finished.
+    void wait_idle();
+
+    // Runs f(i) for i in [0, n) on the pool plus the calling thread and
+    // returns when all calls (and all helper tasks) are done. Not for use
+    // from inside this pool's own tasks.
+    template <typename F>
+    void parallel_for(std::size_t n, F&& f);
+
+    std::size_t size() const { return workers_.size(); }
+    std::uint64_t tasks_completed() const { return completed_.load(std::memory_order_relaxed); }
+    std::uint64_t tasks_stolen() const { return stolen_.load(std::memory_order_relaxed); }
+
+private:
+    // Double-ended ring of tasks; storage doubles when full and is never
+    // released, unlike std::deque which frees and reallocates blocks as the
+    // ends move.
+    class TaskRing {
+    public:
+        TaskRing() : slots_(kInitialSlots) {}
+
+        bool empty() const { return size_ == 0; }
+
+        void push_back(Task task) {
+            if (size_ == slots_.size()) {
+                grow();
+            }
+            slots_[(head_ + size_) & (slots_.size() - 1)] = std::move(task);
+            ++size_;
+        }
+
+        Task pop_back() {
+            --size_;
+            return std::move(slots_[(head_ + size_) & (slots_.size() - 1)]);
+        }
+
+        Task pop_front() {
+            Task t = std::move(slots_[head_]);
+            head_ = (head_ + 1) & (slots_.size() - 1);
+            --size_;
+            return t;
+        }
+
+    private:
+        static constexpr std::size_t kInitialSlots = 64;  // power of two
+
+        void grow() {
+            std::vector<Task> bigger(slots_.size() * 2);
+            for (std::size_t i = 0; i < size_; ++i) {
+                bigger[i] = std::move(slots_[(head_ + i) & (slots_.size() - 1)]);
+            }
+            slots_ = std::move(bigger);
+            head_ = 0;
+        }
+
+        std::vector<Task> slots_;
+        std::size_t head_ = 0;
+        std::size_t size_ = 0;
+    };
+
+    struct Worker {
+        std::mutex mutex;
+        TaskRing tasks;
+    };
+
+    void run(std::size_t self);
+    bool try_pop_local(std::size_t self, Task& out);
+    bool try_steal(std::size_t self, Task& out);
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::thread> threads_;
+
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+    std::condition_variable idle_;
+    std::atomic<std::size_t> queued_{0};
+    std::atomic<std::size_t> running_{0};
+    std::atomic<std::size_t> next_{0};
+    std::atomic<std::uint64_t> completed_{0};
+    std::atomic<std::uint64_t> stolen_{0};
+    bool stop_ = false;  // guarded by wake_mutex_
+};
+
+template <typename F>
+void ThreadPool::parallel_for(std::size_t n, F&& f) {
+    struct Context {
+        std::remove_reference_t<F>* f;
+        std::size_t n;
+        std::atomic<std::size_t> next{0};
+        std::atomic<std::size_t> helpers{0};
+
+        void work() {
+            for (std::size_t i = next.fetch_add(1, std::memory_order_relaxed); i < n;
+                 i = next.fetch_add(1, std::memory_order_relaxed)) {
+                (*f)(i);
+            }
+        }
+    };
+
+    Context ctx;
+    ctx.f = &f;
+    ctx.n = n;
+    const std::size_t helpers = n > 1 ? std::min(workers_.size(), n - 1) : 0;
+    ctx.helpers.store(helpers, std::memory_order_relaxed);
+    for (std::size_t h = 0; h < helpers; ++h) {
+        Context* c = &ctx;
+        submit([c] {
+            c->work();
+            c->helpers.fetch_sub(1, std::memory_order_release);
+        });
+    }
+    ctx.work();
+    // Helpers hold a pointer to ctx: wait until every one of them has left.
+    while (ctx.helpers.load(std::memory_order_acquire) != 0) {
+        std::this_thread::yield();
+    }
+}
+
+}  // namespace merton
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace merton {
+
+// One recorded trade/mid: the raw tick file format is a packed array of
+// these (16 bytes each, host byte order, no header).
+struct TickRecord {
+    double price;
+    std::int64_t epoch_us;
+};
+static_assert(sizeof(TickRecord) == 16, "TickRecord must be packed");
+
+// Read-only memory mapping of a raw tick file. Move-only; unmaps on
+// destruction.
+class MappedTickFile {
+public:
+    MappedTickFile() = default;
+    ~MappedTickFile();
+
+    MappedTickFile(const MappedTickFile&) = delete;
+    MappedTickFile& operator=(const MappedTickFile&) = delete;
+    MappedTickFile(MappedTickFile&& other) noexcept;
+    MappedTickFile& operator=(MappedTickFile&& other) noexcept;
+
+    // Returns false (errno set) if the file cannot be opened or mapped, or
+    // its size is not a multiple of sizeof(TickRecord).
+    bool open(const std::string& path);
+    void close();
+
+    std::span<const TickRecord> ticks() const { return {data_, size_}; }
+    bool is_open() const { return open_; }
+
+private:
+    bool open_ = false;
+    void* base_ = nullptr;
+    std::size_t bytes_ = 0;
+    const TickRecord* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+// Writes ticks in the raw format. Returns false on I/O error.
+bool write_tick_file(const std::string& path, std::span<const TickRecord> ticks);
+
+}  // namespace merton
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "merton_params.hpp"
+
+#include <cstdint>
+#include <optional>
+
+namespace merton {
+
+struct FilteredTick {
+    double price;
+    std::int64_t epoch_us;
+};
+
+// Ticks dropped by TickFilter, by stage.
+struct TickFilterCounts {
+    std::uint64_t duplicate_price = 0;  // same price as the last tick passed on
+    std::uint64_t min_dt = 0;           // closer than min_tick_dt_us to it
+    std::uint64_t bar = 0;              // inside a bar that closes on a later tick
+};
+
+// Pre-ingestion sampling stage between update_tick and return formation,
+// configured by the CalibratorConfig tick filter fields. Stages, in order:
+//   - bar sampling: one tick per time bar (its last, passed on when the first
+//     tick of a later bar arrives) or per volume bar (the tick that completes
+//     bar_size volume)
+//   - duplicate-price suppression against the last tick passed on
+//   - minimum-dt coalescing: ticks within min_tick_dt_us of the last one
+//     passed on are dropped
+// Log returns telescope, so a dropped tick's move is carried by the next
+// return rather than lost. Ingestion thread only; no allocation.
+class TickFilter {
+public:
+    explicit TickFilter(const CalibratorConfig& config);
+
+    // False when every stage is off and push() would pass every tick as is.
+    bool active() const { return active_; }
+    // The tick to form the next return from, if any; price must be > 0.
+    std::optional<FilteredTick> push(double price, std::int64_t epoch_us, double volume = 1.0);
+    const TickFilterCounts& counts() const { return counts_; }
+    std::uint64_t dropped() const { return counts_.duplicate_price + counts_.min_dt + counts_.bar; }
+    // Forgets the last tick, any open bar and the counts.
+    void reset();
+
+private:
+    std::optional<FilteredTick> pass(const FilteredTick& tick);
+
+    bool suppress_duplicates_;
+    std::int64_t min_dt_us_;
+    TickBars bars_;
+    double bar_size_;
+    bool active_;
+
+    std::optional<FilteredTick> last_;  // last tick passed on
+    std::optional<FilteredTick> open_;  // time bars: latest tick of the open bar
+    std::int64_t open_bar_ = 0;
+    double bar_volume_ = 0.0;           // volume bars: volume since the last bar
+    TickFilterCounts counts_;
+};
+
+}  // namespace merton
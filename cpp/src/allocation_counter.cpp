@@ -0,0 +1,126 @@
+// -----------------------------------------------------------------------------
+// allocation_counter.cpp
+// -----------------------------------------------------------------------------
+//
+// Scoped heap-allocation counter for MERTON_COUNT_ALLOCATIONS builds. The
+// replaced operator new / delete forward to malloc / free (aligned_alloc for
+// over-aligned types) and bump a relaxed counter when the calling thread is
+// inside an AllocationScope. Only code linked into the same binary as this
+// file (the Python module, a test driver) is seen.
+// -----------------------------------------------------------------------------
+
+#include "allocation_counter.hpp"
+
+#ifdef MERTON_COUNT_ALLOCATIONS
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace merton {
+
+namespace {
+
+std::atomic<std::uint64_t> g_allocations{0};
+thread_local unsigned tls_scope_depth = 0;
+
+void* counted_alloc(std::size_t size, std::size_t align) {
+    if (tls_scope_depth > 0) {
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (size == 0) {
+        size = 1;
+    }
+    void* p = align > alignof(std::max_align_t)
+        ? std::aligned_alloc(align, (size + align - 1) / align * align)
+        : std::malloc(size);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+}  // namespace
+
+bool allocation_counting_enabled() {
+    return true;
+}
+
+std::uint64_t allocation_count() {
+    return g_allocations.load(std::memory_order_relaxed);
+}
+
+AllocationScope::AllocationScope() {
+    ++tls_scope_depth;
+}
+
+AllocationScope::~AllocationScope() {
+    --tls_scope_depth;
+}
+
+}  // namespace merton
+
+void* operator new(std::size_t size) {
+    return merton::counted_alloc(size, alignof(std::max_align_t));
+}
+
+void* operator new[](std::size_t size) {
+    return merton::counted_alloc(size, alignof(std::max_align_t));
+}
+
+void* operator new(std::size_t size, std::align_val_t align) {
+    return merton::counted_alloc(size, static_cast<std::size_t>(align));
+}
+
+void* operator new[](std::size_t size, std::align_val_t align) {
+    return merton::counted_alloc(size, static_cast<std::size_t>(align));
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+#else
+
+namespace merton {
+
+bool allocation_counting_enabled() {
+    return false;
+}
+
+std::uint64_t allocation_count() {
+    return 0;
+}
+
+}  // namespace merton
+
+#endif
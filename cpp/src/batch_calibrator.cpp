@@ -0,0 +1,275 @@
+// -----------------------------------------------------------------------------
+// batch_calibrator.cpp
+// -----------------------------------------------------------------------------
+//
+// Offline calibration over historical ticks (see batch_calibrator.hpp).
+//
+// Returns are formed in two parallel passes over fixed-size tick chunks:
+// count the valid returns of each chunk, prefix-sum the counts, then write
+// every chunk's returns at its offset. A chunk starts from the last valid
+// tick before it (a short backward scan), so the series is exactly what
+// update_tick would have built from the same ticks.
+//
+// Work is split into fixed-size chunks rather than one per thread, so the
+// chunk sums (and hence the fitted params) are the same for any thread
+// count. The caller thread takes part in every parallel_for.
+// -----------------------------------------------------------------------------
+
+#include "batch_calibrator.hpp"
+
+#include "box_lbfgs.hpp"
+#include "merton_likelihood.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <thread>
+
+namespace merton {
+
+namespace {
+
+// Seconds in one year (used to convert dt_us -> dt_years).
+constexpr double kSecsPerYear = 365.25 * 24.0 * 3600.0;
+// Ticks per return-formation task.
+constexpr std::size_t kTickChunk = 1 << 16;
+// Returns per NLL reduction task.
+constexpr std::size_t kReturnChunk = 1 << 14;
+
+struct ReturnSeries {
+    std::vector<double> r;
+    std::vector<std::int64_t> dt_us;
+    std::vector<std::int64_t> end_us;  // timestamp of the tick closing each return
+
+    std::size_t size() const { return r.size(); }
+};
+
+/// parallel_for on pool (plus the caller), or a plain loop without one.
+template <typename F>
+void run_parallel(ThreadPool* pool, std::size_t n, F&& f) {
+    if (pool && n > 1) {
+        pool->parallel_for(n, f);
+        return;
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        f(i);
+    }
+}
+
+/// Helper pool for threads - 1 workers, or none when one thread suffices.
+std::unique_ptr<ThreadPool> make_pool(std::size_t threads) {
+    const std::size_t n = threads > 0 ? threads : std::max(1u, std::thread::hardware_concurrency());
+    return n > 1 ? std::make_unique<ThreadPool>(n - 1) : nullptr;
+}
+
+std::size_t chunk_count(std::size_t n, std::size_t chunk) {
+    return (n + chunk - 1) / chunk;
+}
+
+// -----------------------------------------------------------------------------
+// Return formation
+// -----------------------------------------------------------------------------
+
+ReturnSeries form_returns(std::span<const double> prices, std::span<const std::int64_t> epoch_us, ThreadPool* pool) {
+    const std::size_t n = std::min(prices.size(), epoch_us.size());
+    const std::size_t chunks = chunk_count(n, kTickChunk);
+
+    // Visits the valid returns closed by ticks [begin, end) in order.
+    const auto scan = [&](std::size_t chunk, auto&& emit) {
+        const std::size_t begin = chunk * kTickChunk;
+        const std::size_t end = std::min(n, begin + kTickChunk);
+        std::size_t prev = begin;
+        while (prev > 0 && !(prices[prev - 1] > 0.0)) {
+            --prev;
+        }
+        bool has_prev = prev > 0;
+        double last_price = has_prev ? prices[prev - 1] : 0.0;
+        std::int64_t last_ts = has_prev ? epoch_us[prev - 1] : 0;
+        for (std::size_t i = begin; i < end; ++i) {
+            if (!(prices[i] > 0.0)) {
+                continue;
+            }
+            if (has_prev) {
+                const std::int64_t dt_us = epoch_us[i] - last_ts;
+                const double r = std::log(prices[i] / last_price);
+                if (dt_us > 0 && std::isfinite(r)) {
+                    emit(r, dt_us, epoch_us[i]);
+                }
+            }
+            has_prev = true;
+            last_price = prices[i];
+            last_ts = epoch_us[i];
+        }
+    };
+
+    std::vector<std::size_t> offsets(chunks + 1, 0);
+    run_parallel(pool, chunks, [&](std::size_t c) {
+        std::size_t count = 0;
+        scan(c, [&](double, std::int64_t, std::int64_t) { ++count; });
+        offsets[c + 1] = count;
+    });
+    for (std::size_t c = 0; c < chunks; ++c) {
+        offsets[c + 1] += offsets[c];
+    }
+
+    ReturnSeries out;
+    out.r.resize(offsets[chunks]);
+    out.dt_us.resize(offsets[chunks]);
+    out.end_us.resize(offsets[chunks]);
+    run_parallel(pool, chunks, [&](std::size_t c) {
+        std::size_t k = offsets[c];
+        scan(c, [&](double r, std::int64_t dt_us, std::int64_t ts) {
+            out.r[k] = r;
+            out.dt_us[k] = dt_us;
+            out.end_us[k] = ts;
+            ++k;
+        });
+    });
+    return out;
+}
+
+// -----------------------------------------------------------------------------
+// One fit
+// -----------------------------------------------------------------------------
+//
+// Projected L-BFGS in box-normalized coordinates (as the online lbfgsb
+// optimizer) on returns [first, first + count) of the series. Each
+// evaluation reduces kReturnChunk-sized partial NLLs and gradients, on the
+// pool when given one.
+// -----------------------------------------------------------------------------
+
+double median_dt_years(std::span<const std::int64_t> dt_us) {
+    std::vector<std::int64_t> scratch(dt_us.begin(), dt_us.end());
+    const auto mid = scratch.begin() + static_cast<std::ptrdiff_t>(scratch.size() / 2);
+    std::nth_element(scratch.begin(), mid, scratch.end());
+    return static_cast<double>(*mid) / 1e6 / kSecsPerYear;
+}
+
+BatchFit fit_returns(const ReturnSeries& series, std::size_t first, std::size_t count, const MertonParams& initial,
+                     const CalibratorConfig& config, const BatchOptions& options, ThreadPool* pool) {
+    using Vec = BoxLbfgs<4>::Vec;
+    const Vec lo{kParamLower.sigma, kParamLower.lambda, kParamLower.mu_j, kParamLower.delta_j};
+    const Vec hi{kParamUpper.sigma, kParamUpper.lambda, kParamUpper.mu_j, kParamUpper.delta_j};
+    const auto to_params = [&](const Vec& u) {
+        return MertonParams{
+            lo[0] + u[0] * (hi[0] - lo[0]),
+            lo[1] + u[1] * (hi[1] - lo[1]),
+            lo[2] + u[2] * (hi[2] - lo[2]),
+            lo[3] + u[3] * (hi[3] - lo[3]),
+        };
+    };
+    const MertonParams start{
+        std::clamp(initial.sigma, lo[0], hi[0]),
+        std::clamp(initial.lambda, lo[1], hi[1]),
+        std::clamp(initial.mu_j, lo[2], hi[2]),
+        std::clamp(initial.delta_j, lo[3], hi[3]),
+    };
+
+    BatchFit fit;
+    fit.sigma = start.sigma;
+    fit.lambda = start.lambda;
+    fit.mu_j = start.mu_j;
+    fit.delta_j = start.delta_j;
+    if (count < 2) {
+        return fit;
+    }
+    const std::span<const double> x(series.r.data() + first, count);
+    const double dt = median_dt_years(std::span<const std::int64_t>(series.dt_us.data() + first, count));
+    if (!(dt > 0.0)) {
+        return fit;
+    }
+
+    const std::size_t chunks = chunk_count(count, kReturnChunk);
+    std::vector<double> part_nll(chunks);
+    std::vector<MertonParams> part_grad(chunks);
+    const auto fg = [&](const Vec& u, Vec& g) {
+        const MertonParams p = to_params(u);
+        const MixtureTerms terms =
+            make_mixture_terms(p, dt, config.n_max, config.poisson_tail_eps, config.mixture_eval);
+        run_parallel(pool, chunks, [&](std::size_t c) {
+            const std::size_t begin = c * kReturnChunk;
+            const std::size_t len = std::min(kReturnChunk, count - begin);
+            part_nll[c] = mixture_nll_gradient(terms, p, dt, x.subspan(begin, len), {}, part_grad[c]);
+        });
+        double nll = 0.0;
+        MertonParams grad{0.0, 0.0, 0.0, 0.0};
+        for (std::size_t c = 0; c < chunks; ++c) {
+            nll += part_nll[c];
+            grad.sigma += part_grad[c].sigma;
+            grad.lambda += part_grad[c].lambda;
+            grad.mu_j += part_grad[c].mu_j;
+            grad.delta_j += part_grad[c].delta_j;
+        }
+        g = Vec{
+            grad.sigma * (hi[0] - lo[0]),
+            grad.lambda * (hi[1] - lo[1]),
+            grad.mu_j * (hi[2] - lo[2]),
+            grad.delta_j * (hi[3] - lo[3]),
+        };
+        return nll;
+    };
+
+    BoxLbfgsOptions lbfgs;
+    lbfgs.max_iterations = options.max_iterations;
+    lbfgs.f_tol = config.improvement_tol;
+    BoxLbfgs<4> solver(Vec{0.0, 0.0, 0.0, 0.0}, Vec{1.0, 1.0, 1.0, 1.0}, lbfgs);
+    const Vec u0{
+        (start.sigma - lo[0]) / (hi[0] - lo[0]),
+        (start.lambda - lo[1]) / (hi[1] - lo[1]),
+        (start.mu_j - lo[2]) / (hi[2] - lo[2]),
+        (start.delta_j - lo[3]) / (hi[3] - lo[3]),
+    };
+    const auto result = solver.minimize(u0, fg);
+
+    fit.start_us = series.end_us[first] - series.dt_us[first];
+    fit.end_us = series.end_us[first + count - 1];
+    fit.returns = count;
+    fit.iterations = result.iterations;
+    if (std::isfinite(result.f)) {
+        const MertonParams p = to_params(result.x);
+        fit.sigma = p.sigma;
+        fit.lambda = p.lambda;
+        fit.mu_j = p.mu_j;
+        fit.delta_j = p.delta_j;
+        fit.nll = result.f;
+    } else {
+        Vec g;
+        fit.nll = fg(u0, g);
+    }
+    return fit;
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+// Entry points
+// -----------------------------------------------------------------------------
+
+BatchFit calibrate_batch(std::span<const double> prices, std::span<const std::int64_t> epoch_us,
+                         const MertonParams& initial, const CalibratorConfig& config, const BatchOptions& options) {
+    const std::unique_ptr<ThreadPool> pool = make_pool(options.threads);
+    const ReturnSeries series = form_returns(prices, epoch_us, pool.get());
+    return fit_returns(series, 0, series.size(), initial, config, options, pool.get());
+}
+
+std::vector<BatchFit> calibrate_rolling(std::span<const double> prices, std::span<const std::int64_t> epoch_us,
+                                        const MertonParams& initial, const CalibratorConfig& config,
+                                        const BatchOptions& options) {
+    const std::unique_ptr<ThreadPool> pool = make_pool(options.threads);
+    const ReturnSeries series = form_returns(prices, epoch_us, pool.get());
+    const std::size_t window = options.window;
+    const std::size_t step = options.step > 0 ? options.step : window;
+    if (window < 2 || series.size() < window) {
+        return {};
+    }
+
+    // Windows are the parallel unit here; each fit runs on one thread.
+    std::vector<BatchFit> fits((series.size() - window) / step + 1);
+    run_parallel(pool.get(), fits.size(), [&](std::size_t i) {
+        fits[i] = fit_returns(series, i * step, window, initial, config, options, nullptr);
+    });
+    return fits;
+}
+
+}  // namespace merton
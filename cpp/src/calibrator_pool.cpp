@@ -0,0 +1,184 @@
+// -----------------------------------------------------------------------------
+// calibrator_pool.cpp
+// -----------------------------------------------------------------------------
+//
+// Multi-symbol front end over OnlineMertonCalibrator.
+//
+// Flow per symbol:
+//   1. update_tick(symbol, price, ts): push to the slot inbox (SPSC, producer
+//      = quote callback thread), schedule a drain task if none is pending
+//   2. drain task (pool worker): feed inbox ticks into the slot calibrator,
+//      running maybe_update_params() at its configured cadence
+//   3. fair_value / params: seqlock reads of the calibrator's published params
+//
+// The scheduled flag gives each slot at most one task in flight, so a
+// calibrator is never touched by two workers at once. When several symbols
+// cross update_every_n_returns together, their drains run on different
+// workers and idle workers steal queued drains.
+// -----------------------------------------------------------------------------
+
+#include "calibrator_pool.hpp"
+
+#include <stdexcept>
+
+namespace merton {
+
+namespace {
+
+/// Pool slots always run their calibrator synchronously inside drain tasks,
+/// and without a per-slot search pool (jacobi / global search evaluate on
+/// the drain thread), so workers_ is the only parallelism.
+CalibratorConfig slot_config(CalibratorConfig config) {
+    config.async_recalibration = false;
+    config.search_threads = 1;
+    return config;
+}
+
+}  // namespace
+
+CalibratorPool::Slot::Slot(MertonParams initial, const CalibratorConfig& config)
+    : calibrator(initial, slot_config(config)), inbox(config.async_queue_capacity) {}
+
+CalibratorPool::CalibratorPool(CalibratorConfig config, std::size_t threads)
+    : config_(config), started_(std::chrono::steady_clock::now()), workers_(threads) {}
+
+CalibratorPool::~CalibratorPool() {
+    workers_.wait_idle();
+}
+
+bool CalibratorPool::add_symbol(const std::string& symbol, MertonParams initial) {
+    if (slots_.contains(symbol)) {
+        return false;
+    }
+    slots_.emplace(symbol, std::make_unique<Slot>(initial, config_));
+    return true;
+}
+
+bool CalibratorPool::has_symbol(const std::string& symbol) const {
+    return slots_.contains(symbol);
+}
+
+// -----------------------------------------------------------------------------
+// Routing and scheduling
+// -----------------------------------------------------------------------------
+//
+// The producer publishes the tick and then tests-and-sets scheduled; the
+// drain task clears scheduled and then re-checks the inbox. The seq_cst
+// fences on both sides order each store before the other side's load, so a
+// tick can never be left in an idle inbox.
+// -----------------------------------------------------------------------------
+
+bool CalibratorPool::update_tick(const std::string& symbol, double price, std::int64_t epoch_us) {
+    const auto it = slots_.find(symbol);
+    if (it == slots_.end()) {
+        return false;
+    }
+    Slot& s = *it->second;
+    s.ticks_routed.fetch_add(1, std::memory_order_relaxed);
+    if (!s.inbox.try_push(Tick{price, epoch_us})) {
+        s.ticks_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    schedule(s);
+    return true;
+}
+
+void CalibratorPool::schedule(Slot& s) {
+    if (!s.scheduled.exchange(true, std::memory_order_acq_rel)) {
+        workers_.submit([this, &s] { drain(s); });
+    }
+}
+
+void CalibratorPool::drain(Slot& s) {
+    for (;;) {
+        while (const std::optional<Tick> t = s.inbox.try_pop()) {
+            if (!s.calibrator.update_tick(t->price, t->epoch_us)) {
+                continue;
+            }
+            s.returns_accepted.fetch_add(1, std::memory_order_relaxed);
+            if (s.calibrator.maybe_update_params()) {
+                s.param_updates.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        s.scheduled.store(false, std::memory_order_release);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (s.inbox.size() == 0 || s.scheduled.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+    }
+}
+
+void CalibratorPool::flush() {
+    workers_.wait_idle();
+}
+
+// -----------------------------------------------------------------------------
+// Published state
+// -----------------------------------------------------------------------------
+
+const CalibratorPool::Slot& CalibratorPool::slot(const std::string& symbol) const {
+    const auto it = slots_.find(symbol);
+    if (it == slots_.end()) {
+        throw std::out_of_range("unknown symbol: " + symbol);
+    }
+    return *it->second;
+}
+
+MertonParams CalibratorPool::params(const std::string& symbol) const {
+    return slot(symbol).calibrator.params();
+}
+
+std::uint64_t CalibratorPool::params_version(const std::string& symbol) const {
+    return slot(symbol).calibrator.params_version();
+}
+
+double CalibratorPool::fair_value(
+    const std::string& symbol, double s0, double q_annual, double t_years, double r) const {
+    return slot(symbol).calibrator.fair_value(s0, q_annual, t_years, r);
+}
+
+bool CalibratorPool::fair_values(const std::string& symbol, std::span<const double> s0,
+                                 std::span<const double> q_annual, std::span<const double> t_years,
+                                 std::span<const double> r, std::span<double> out) const {
+    return slot(symbol).calibrator.fair_values(s0, q_annual, t_years, r, out);
+}
+
+std::size_t CalibratorPool::queue_depth(const std::string& symbol) const {
+    return slot(symbol).inbox.size();
+}
+
+SymbolStats CalibratorPool::symbol_stats(const std::string& symbol) const {
+    const Slot& s = slot(symbol);
+    SymbolStats out;
+    out.queue_depth = s.inbox.size();
+    out.sample_count = s.calibrator.sample_count();
+    out.ticks_routed = s.ticks_routed.load(std::memory_order_relaxed);
+    out.ticks_dropped = s.ticks_dropped.load(std::memory_order_relaxed);
+    out.returns_accepted = s.returns_accepted.load(std::memory_order_relaxed);
+    out.param_updates = s.param_updates.load(std::memory_order_relaxed);
+    out.params_version = s.calibrator.params_version();
+    return out;
+}
+
+PoolStats CalibratorPool::stats() const {
+    PoolStats out;
+    out.symbols = slots_.size();
+    out.threads = workers_.size();
+    for (const auto& [symbol, s] : slots_) {
+        out.ticks_routed += s->ticks_routed.load(std::memory_order_relaxed);
+        out.ticks_dropped += s->ticks_dropped.load(std::memory_order_relaxed);
+        out.returns_accepted += s->returns_accepted.load(std::memory_order_relaxed);
+        out.param_updates += s->param_updates.load(std::memory_order_relaxed);
+    }
+    out.tasks_stolen = workers_.tasks_stolen();
+    out.elapsed_seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - started_).count();
+    if (out.elapsed_seconds > 0.0) {
+        out.ticks_per_second = static_cast<double>(out.ticks_routed) / out.elapsed_seconds;
+        out.param_updates_per_second = static_cast<double>(out.param_updates) / out.elapsed_seconds;
+    }
+    return out;
+}
+
+}  // namespace merton
@@ -0,0 +1,313 @@
+// -----------------------------------------------------------------------------
+// calibrator_snapshot.cpp
+// -----------------------------------------------------------------------------
+//
+// Warm-start snapshot / restore for OnlineMertonCalibrator.
+//
+// Blob layout (native endianness, no padding between fields):
+//
+//   magic "MRTNSNP1" | u32 version | u32 sizeof(CalibratorConfig)
+//   CalibratorConfig (raw) | MertonParams (raw)
+//   u8 has_last_tick | f64 last_price | i64 last_epoch_us
+//   u64 returns_since_last_update | u64 n
+//   f64 returns[n] | i64 dt_us[n]      (FIFO order, oldest first)
+//   u64 FNV-1a of everything above
+//
+// Only the window is stored; the histograms and the dt median are derived
+// from it and are rebuilt by replaying the samples through append_return,
+// which keeps the format independent of their internal layout. online_em
+// statistics are rebuilt the same way, scored under the restored params;
+// online_sgd takes no steps during the replay and restarts its moments.
+// -----------------------------------------------------------------------------
+
+#include "merton_online_calibrator.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+
+namespace merton {
+
+namespace {
+
+constexpr char kSnapshotMagic[8] = {'M', 'R', 'T', 'N', 'S', 'N', 'P', '1'};
+constexpr std::uint32_t kSnapshotVersion = 1;
+
+static_assert(std::is_trivially_copyable_v<CalibratorConfig>);
+static_assert(std::is_trivially_copyable_v<MertonParams>);
+
+// Upper bounds on the sizes restore() (re)allocates and the threads it
+// starts from a blob's config; far beyond any real configuration.
+constexpr std::size_t kMaxRestoredBuffer = std::size_t{1} << 26;
+constexpr std::size_t kMaxRestoredThreads = 1024;
+
+/// True if the byte behind a raw-copied bool is 0 or 1.
+bool bool_valid(const bool& b) {
+    std::uint8_t byte = 0;
+    std::memcpy(&byte, &b, 1);
+    return byte <= 1;
+}
+
+/// Every CalibratorConfig field the constructor and the engines rely on is
+/// usable, so restore() can rebuild from cfg without failing half-way.
+bool config_valid(const CalibratorConfig& cfg) {
+    auto enum_le = [](auto v, auto last) { return static_cast<unsigned>(v) <= static_cast<unsigned>(last); };
+    return cfg.window_size > 0 && cfg.window_size <= kMaxRestoredBuffer && cfg.n_max > 0 &&
+           cfg.search_threads <= kMaxRestoredThreads && cfg.global_search_starts <= kMaxRestoredBuffer &&
+           cfg.async_queue_capacity > 0 && cfg.async_queue_capacity <= kMaxRestoredBuffer &&
+           cfg.dt_bucket_sub_bits <= kMaxDtBucketSubBits &&
+           enum_le(cfg.mixture_eval, MixtureEval::fast) && enum_le(cfg.search_mode, SearchMode::jacobi) &&
+           enum_le(cfg.optimizer, OptimizerMode::online_sgd) && enum_le(cfg.tick_bars, TickBars::volume) &&
+           bool_valid(cfg.suppress_duplicate_prices) && bool_valid(cfg.heterogeneous_dt) &&
+           bool_valid(cfg.async_recalibration);
+}
+
+std::uint64_t fnv1a(std::span<const std::uint8_t> bytes) {
+    std::uint64_t h = 14695981039346656037ull;
+    for (std::uint8_t b : bytes) {
+        h = (h ^ b) * 1099511628211ull;
+    }
+    return h;
+}
+
+/// Appends trivially copyable values to a byte vector.
+class BlobWriter {
+public:
+    explicit BlobWriter(std::vector<std::uint8_t>& out) : out_(out) {}
+
+    template <typename T>
+    void put(const T& v) {
+        const auto* p = reinterpret_cast<const std::uint8_t*>(&v);
+        out_.insert(out_.end(), p, p + sizeof(T));
+    }
+
+private:
+    std::vector<std::uint8_t>& out_;
+};
+
+/// Bounds-checked reads from a blob; ok() turns false on the first overrun.
+class BlobReader {
+public:
+    explicit BlobReader(std::span<const std::uint8_t> in) : in_(in) {}
+
+    template <typename T>
+    bool get(T& v) {
+        if (!ok_ || in_.size() - pos_ < sizeof(T)) {
+            ok_ = false;
+            return false;
+        }
+        std::memcpy(&v, in_.data() + pos_, sizeof(T));
+        pos_ += sizeof(T);
+        return true;
+    }
+
+    std::span<const std::uint8_t> take(std::size_t n) {
+        if (!ok_ || in_.size() - pos_ < n) {
+            ok_ = false;
+            return {};
+        }
+        const auto s = in_.subspan(pos_, n);
+        pos_ += n;
+        return s;
+    }
+
+    bool ok() const { return ok_; }
+    std::size_t remaining() const { return in_.size() - pos_; }
+
+private:
+    std::span<const std::uint8_t> in_;
+    std::size_t pos_ = 0;
+    bool ok_ = true;
+};
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+// Snapshot
+// -----------------------------------------------------------------------------
+//
+// In async mode the window belongs to the worker, so it is stopped for the
+// copy; returns still queued are applied first so the snapshot covers every
+// accepted tick. The worker is restarted before returning.
+// -----------------------------------------------------------------------------
+
+std::vector<std::uint8_t> OnlineMertonCalibrator::snapshot() {
+    const bool paused = worker_.joinable();
+    if (paused) {
+        stop_worker();
+        while (const std::optional<PendingReturn> item = queue_->try_pop()) {
+            append_return(item->r, item->dt_us);
+        }
+    }
+
+    const std::size_t n = window_.size();
+    std::vector<std::uint8_t> blob;
+    blob.reserve(64 + sizeof(CalibratorConfig) + sizeof(MertonParams) + n * 16);
+    BlobWriter w(blob);
+    w.put(kSnapshotMagic);
+    w.put(kSnapshotVersion);
+    w.put(static_cast<std::uint32_t>(sizeof(CalibratorConfig)));
+    w.put(config_);
+    w.put(params_);
+    const bool has_last = last_price_.has_value() && last_ts_us_.has_value();
+    w.put(static_cast<std::uint8_t>(has_last));
+    w.put(has_last ? *last_price_ : 0.0);
+    w.put(has_last ? *last_ts_us_ : std::int64_t{0});
+    w.put(static_cast<std::uint64_t>(returns_since_last_update_));
+    w.put(static_cast<std::uint64_t>(n));
+    for (const double r : window_.returns()) {
+        w.put(r);
+    }
+    for (const std::int64_t dt : window_.dt_us()) {
+        w.put(dt);
+    }
+    w.put(fnv1a(blob));
+
+    if (paused) {
+        start_worker();
+    }
+    return blob;
+}
+
+// -----------------------------------------------------------------------------
+// Restore
+// -----------------------------------------------------------------------------
+//
+// The blob is fully validated before anything is touched. The config in the
+// blob wins over the constructor's: the window and histograms are rebuilt
+// for it and the samples replayed, the restored params are published as a
+// new version (to the shared segment too while publishing), and only then
+// are the search pool and async worker restarted (init_components), so the
+// worker starts on the full window.
+// -----------------------------------------------------------------------------
+
+bool OnlineMertonCalibrator::restore(std::span<const std::uint8_t> blob) {
+    if (blob.size() < sizeof(std::uint64_t)) {
+        return false;
+    }
+    const std::span<const std::uint8_t> body = blob.first(blob.size() - sizeof(std::uint64_t));
+    std::uint64_t checksum = 0;
+    std::memcpy(&checksum, body.data() + body.size(), sizeof(checksum));
+    if (checksum != fnv1a(body)) {
+        return false;
+    }
+
+    BlobReader in(body);
+    char magic[8];
+    std::uint32_t version = 0;
+    std::uint32_t config_size = 0;
+    CalibratorConfig cfg;
+    MertonParams p;
+    std::uint8_t has_last = 0;
+    double last_price = 0.0;
+    std::int64_t last_ts = 0;
+    std::uint64_t since_update = 0;
+    std::uint64_t n = 0;
+    in.get(magic);
+    in.get(version);
+    in.get(config_size);
+    if (!in.ok() || std::memcmp(magic, kSnapshotMagic, sizeof(magic)) != 0 || version != kSnapshotVersion ||
+        config_size != sizeof(CalibratorConfig)) {
+        return false;
+    }
+    in.get(cfg);
+    in.get(p);
+    in.get(has_last);
+    in.get(last_price);
+    in.get(last_ts);
+    in.get(since_update);
+    in.get(n);
+    if (!in.ok() || n > cfg.window_size || in.remaining() != n * (sizeof(double) + sizeof(std::int64_t))) {
+        return false;
+    }
+    const std::span<const std::uint8_t> returns = in.take(n * sizeof(double));
+    const std::span<const std::uint8_t> dts = in.take(n * sizeof(std::int64_t));
+    if (!config_valid(cfg)) {
+        return false;
+    }
+
+    stop_worker();
+    config_ = cfg;
+    params_ = clamp_params(p);
+    window_.reset(config_.window_size);
+    histogram_ = ReturnHistogram(config_.return_quantum, config_.heterogeneous_dt ? 0 : config_.window_size);
+    dt_median_.clear();
+    returns_since_last_update_ = 0;
+    sample_count_.store(0, std::memory_order_relaxed);
+    reset_engines();
+    last_fit_returns_ = 0;
+    filter_ = TickFilter(config_);
+
+    dt_histogram_.reset();
+    if (config_.heterogeneous_dt) {
+        dt_histogram_ = std::make_unique<DtBucketedHistogram>(config_.return_quantum, config_.dt_bucket_sub_bits);
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        double r = 0.0;
+        std::int64_t dt_us = 0;
+        std::memcpy(&r, returns.data() + i * sizeof(double), sizeof(double));
+        std::memcpy(&dt_us, dts.data() + i * sizeof(std::int64_t), sizeof(std::int64_t));
+        if (dt_us > 0 && std::isfinite(r)) {
+            append_return(r, dt_us, false);
+        }
+    }
+    returns_since_last_update_ = since_update;
+    if (has_last != 0) {
+        last_price_ = last_price;
+        last_ts_us_ = last_ts;
+    } else {
+        last_price_.reset();
+        last_ts_us_.reset();
+    }
+
+    publish();
+    last_polled_version_ = published_.version();
+    if (shared_) {
+        publish_shared();
+    }
+    init_components();
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// Snapshot files
+// -----------------------------------------------------------------------------
+//
+// save_snapshot writes to "<path>.tmp" and renames it into place, so a crash
+// mid-write never leaves a truncated snapshot behind.
+// -----------------------------------------------------------------------------
+
+bool OnlineMertonCalibrator::save_snapshot(const std::string& path) {
+    const std::vector<std::uint8_t> blob = snapshot();
+    const std::string tmp = path + ".tmp";
+    std::FILE* f = std::fopen(tmp.c_str(), "wb");
+    if (f == nullptr) {
+        return false;
+    }
+    bool ok = std::fwrite(blob.data(), 1, blob.size(), f) == blob.size();
+    ok = std::fclose(f) == 0 && ok;
+    if (!ok || std::rename(tmp.c_str(), path.c_str()) != 0) {
+        std::remove(tmp.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool OnlineMertonCalibrator::load_snapshot(const std::string& path) {
+    std::FILE* f = std::fopen(path.c_str(), "rb");
+    if (f == nullptr) {
+        return false;
+    }
+    std::vector<std::uint8_t> blob;
+    std::uint8_t buf[1 << 16];
+    std::size_t got = 0;
+    while ((got = std::fread(buf, 1, sizeof(buf), f)) > 0) {
+        blob.insert(blob.end(), buf, buf + got);
+    }
+    const bool read_ok = std::ferror(f) == 0;
+    std::fclose(f);
+    return read_ok && restore(blob);
+}
+
+}  // namespace merton
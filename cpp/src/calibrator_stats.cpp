@@ -0,0 +1,109 @@
+// -----------------------------------------------------------------------------
+// calibrator_stats.cpp
+// -----------------------------------------------------------------------------
+//
+// Summaries for the MERTON_ENABLE_STATS instrumentation (calibrator_stats.hpp).
+// Recording is inline in the header; this file only turns the relaxed
+// counters into a CalibratorStats copy. Readers may race with writers, so a
+// summary can be off by the samples recorded while it was taken.
+// -----------------------------------------------------------------------------
+
+#include "calibrator_stats.hpp"
+
+#include <algorithm>
+#include <initializer_list>
+
+#ifdef MERTON_ENABLE_STATS
+
+namespace merton {
+
+LatencySummary LatencyHistogram::summary() const {
+    std::array<std::uint64_t, kBuckets.count()> counts{};
+    LatencySummary out;
+    for (std::size_t i = 0; i < counts.size(); ++i) {
+        counts[i] = counts_[i].load(std::memory_order_relaxed);
+        out.count += counts[i];
+    }
+    out.max_ns = max_ns_.load(std::memory_order_relaxed);
+    if (out.count == 0) {
+        return out;
+    }
+    out.mean_ns = static_cast<double>(sum_ns_.load(std::memory_order_relaxed)) / static_cast<double>(out.count);
+
+    // Smallest bucket whose cumulative count reaches ceil(q * count).
+    auto percentile = [&](double q) {
+        const auto rank = static_cast<std::uint64_t>(q * static_cast<double>(out.count - 1)) + 1;
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < counts.size(); ++i) {
+            seen += counts[i];
+            if (seen >= rank) {
+                return std::min(kBuckets.representative(i), out.max_ns);
+            }
+        }
+        return out.max_ns;
+    };
+    out.p50_ns = percentile(0.50);
+    out.p99_ns = percentile(0.99);
+    out.p999_ns = percentile(0.999);
+    return out;
+}
+
+void LatencyHistogram::reset() {
+    for (auto& c : counts_) {
+        c.store(0, std::memory_order_relaxed);
+    }
+    sum_ns_.store(0, std::memory_order_relaxed);
+    max_ns_.store(0, std::memory_order_relaxed);
+}
+
+void StatsRecorder::recalibrated(double nll_before, double nll_after, bool changed) {
+    bump(recalibrations_);
+    if (changed) {
+        bump(param_updates_);
+    }
+    last_nll_.store(nll_after, std::memory_order_relaxed);
+    last_nll_improvement_.store(nll_before - nll_after, std::memory_order_relaxed);
+}
+
+CalibratorStats StatsRecorder::snapshot() const {
+    CalibratorStats s;
+    s.enabled = true;
+    s.ticks = ticks_.load(std::memory_order_relaxed);
+    s.returns_accepted = returns_accepted_.load(std::memory_order_relaxed);
+    s.rejected_price = rejected_[static_cast<std::size_t>(TickRejection::price)].load(std::memory_order_relaxed);
+    s.rejected_first_tick =
+        rejected_[static_cast<std::size_t>(TickRejection::first_tick)].load(std::memory_order_relaxed);
+    s.rejected_dt = rejected_[static_cast<std::size_t>(TickRejection::dt)].load(std::memory_order_relaxed);
+    s.rejected_non_finite =
+        rejected_[static_cast<std::size_t>(TickRejection::non_finite)].load(std::memory_order_relaxed);
+    s.rejected_queue_full =
+        rejected_[static_cast<std::size_t>(TickRejection::queue_full)].load(std::memory_order_relaxed);
+    s.recalibrations = recalibrations_.load(std::memory_order_relaxed);
+    s.param_updates = param_updates_.load(std::memory_order_relaxed);
+    s.global_searches = global_searches_.load(std::memory_order_relaxed);
+    s.nll_evaluations = nll_evaluations_.load(std::memory_order_relaxed);
+    s.gradient_evaluations = gradient_evaluations_.load(std::memory_order_relaxed);
+    s.last_nll = last_nll_.load(std::memory_order_relaxed);
+    s.last_nll_improvement = last_nll_improvement_.load(std::memory_order_relaxed);
+    s.update_tick = update_tick_.summary();
+    s.recalibration = recalibration_.summary();
+    return s;
+}
+
+void StatsRecorder::reset() {
+    for (std::atomic<std::uint64_t>* c : {&ticks_, &returns_accepted_, &recalibrations_, &param_updates_,
+                                          &global_searches_, &nll_evaluations_, &gradient_evaluations_}) {
+        c->store(0, std::memory_order_relaxed);
+    }
+    for (auto& c : rejected_) {
+        c.store(0, std::memory_order_relaxed);
+    }
+    last_nll_.store(0.0, std::memory_order_relaxed);
+    last_nll_improvement_.store(0.0, std::memory_order_relaxed);
+    update_tick_.reset();
+    recalibration_.reset();
+}
+
+}  // namespace merton
+
+#endif
@@ -0,0 +1,448 @@
+// -----------------------------------------------------------------------------
+// compact_tick_file.cpp
+// -----------------------------------------------------------------------------
+//
+// Columnar delta encoding of (price, epoch_us) streams. Within a block the
+// first tick is stored verbatim in the block header; every later tick stores
+// zigzag(epoch_us - previous) in the timestamp column and zigzag(scaled price
+// - previous) in the price column, both as LEB128 varints. Columns are kept
+// separate so each run of small deltas stays byte-dense.
+//
+// Blocks are self-describing (counts and column sizes in the block header),
+// which lets the reader rebuild the index of a file whose writer never
+// reached close() (or whose index does not match its blocks), and lets the
+// writer resume appending to such a file. Prices are stored as the integer
+// llround(price * price_scale) within +-2^62; append() rejects prices that
+// do not fit (including NaN / inf) rather than encoding a sentinel, so
+// every decoded tick is a real finite price.
+// -----------------------------------------------------------------------------
+
+#include "compact_tick_file.hpp"
+
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace merton {
+
+namespace {
+
+constexpr char kFileMagic[8] = {'M', 'R', 'T', 'N', 'T', 'C', 'K', '1'};
+constexpr char kIndexMagic[8] = {'M', 'R', 'T', 'N', 'I', 'D', 'X', '1'};
+constexpr std::uint32_t kVersion = 1;
+constexpr std::size_t kMaxVarintBytes = 10;
+
+std::uint64_t zigzag(std::int64_t v) {
+    return (static_cast<std::uint64_t>(v) << 1) ^ static_cast<std::uint64_t>(v >> 63);
+}
+
+std::int64_t unzigzag(std::uint64_t v) {
+    return static_cast<std::int64_t>(v >> 1) ^ -static_cast<std::int64_t>(v & 1);
+}
+
+void put_varint(std::vector<std::uint8_t>& out, std::uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back(static_cast<std::uint8_t>(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<std::uint8_t>(v));
+}
+
+/// Decodes one varint from [p, end); returns false if truncated or overlong.
+bool get_varint(const std::uint8_t*& p, const std::uint8_t* end, std::uint64_t& v) {
+    v = 0;
+    for (unsigned shift = 0; shift < 64 && p < end; shift += 7) {
+        const std::uint8_t byte = *p++;
+        v |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::uint64_t padded(std::uint64_t n) {
+    return (n + 7) & ~std::uint64_t{7};
+}
+
+// Scaled prices are kept within +-2^62 so the delta of any two fits in int64.
+constexpr double kMaxScaledPrice = 4611686018427387904.0;  // 2^62
+
+/// llround(price * scale); false if that is not finite or beyond kMaxScaledPrice.
+bool scale_price(double price, double scale, std::int64_t& out) {
+    const double scaled = price * scale;
+    if (!(std::fabs(scaled) < kMaxScaledPrice)) {
+        return false;
+    }
+    out = static_cast<std::int64_t>(std::llround(scaled));
+    return true;
+}
+
+/// Two's complement a + b / a - b: timestamp deltas wrap instead of
+/// overflowing, and decoding wraps back to the same value.
+std::int64_t wrap_add(std::int64_t a, std::int64_t b) {
+    return static_cast<std::int64_t>(static_cast<std::uint64_t>(a) + static_cast<std::uint64_t>(b));
+}
+
+std::int64_t wrap_sub(std::int64_t a, std::int64_t b) {
+    return static_cast<std::int64_t>(static_cast<std::uint64_t>(a) - static_cast<std::uint64_t>(b));
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+// Writer
+// -----------------------------------------------------------------------------
+
+CompactTickWriter::~CompactTickWriter() {
+    close();
+}
+
+bool CompactTickWriter::open(const std::string& path, double price_scale, std::uint32_t block_ticks) {
+    close();
+    if (!(price_scale > 0.0) || block_ticks == 0) {
+        errno = EINVAL;
+        return false;
+    }
+    price_scale_ = price_scale;
+    block_ticks_ = block_ticks;
+    index_.clear();
+    ticks_ = 0;
+    reset_block();
+    ts_bytes_.reserve(static_cast<std::size_t>(block_ticks_) * kMaxVarintBytes);
+    price_bytes_.reserve(static_cast<std::size_t>(block_ticks_) * kMaxVarintBytes);
+
+    struct stat st {};
+    if (::stat(path.c_str(), &st) == 0 && st.st_size > 0) {
+        return recover(path, price_scale);
+    }
+
+    file_ = std::fopen(path.c_str(), "wb");
+    if (file_ == nullptr) {
+        return false;
+    }
+    CompactFileHeader h{};
+    std::memcpy(h.magic, kFileMagic, sizeof(kFileMagic));
+    h.version = kVersion;
+    h.block_ticks = block_ticks_;
+    h.price_scale = price_scale_;
+    if (std::fwrite(&h, sizeof(h), 1, file_) != 1) {
+        std::fclose(file_);
+        file_ = nullptr;
+        return false;
+    }
+    offset_ = sizeof(h);
+    return true;
+}
+
+/// Reopens an existing file for appending: keeps its index, drops the old
+/// index/trailer (or any torn block) and positions at the end of the data.
+bool CompactTickWriter::recover(const std::string& path, double price_scale) {
+    CompactTickReader existing;
+    if (!existing.open(path)) {
+        return false;
+    }
+    if (existing.header().price_scale != price_scale) {
+        errno = EINVAL;
+        return false;
+    }
+    index_.assign(existing.blocks().begin(), existing.blocks().end());
+    ticks_ = existing.tick_count();
+    offset_ = existing.data_end();
+    existing.close();
+
+    if (::truncate(path.c_str(), static_cast<off_t>(offset_)) != 0) {
+        return false;
+    }
+    file_ = std::fopen(path.c_str(), "r+b");
+    if (file_ == nullptr) {
+        return false;
+    }
+    if (std::fseek(file_, static_cast<long>(offset_), SEEK_SET) != 0) {
+        std::fclose(file_);
+        file_ = nullptr;
+        return false;
+    }
+    return true;
+}
+
+void CompactTickWriter::reset_block() {
+    ts_bytes_.clear();
+    price_bytes_.clear();
+    count_ = 0;
+}
+
+bool CompactTickWriter::append(double price, std::int64_t epoch_us) {
+    if (file_ == nullptr) {
+        return false;
+    }
+    std::int64_t scaled = 0;
+    if (!scale_price(price, price_scale_, scaled)) {
+        return false;
+    }
+    if (count_ == 0) {
+        first_ts_ = epoch_us;
+        first_price_ = scaled;
+    } else {
+        put_varint(ts_bytes_, zigzag(wrap_sub(epoch_us, last_ts_)));
+        put_varint(price_bytes_, zigzag(scaled - last_price_));
+    }
+    last_ts_ = epoch_us;
+    last_price_ = scaled;
+    ++count_;
+    return count_ < block_ticks_ || flush();
+}
+
+bool CompactTickWriter::flush() {
+    if (file_ == nullptr) {
+        return false;
+    }
+    if (count_ == 0) {
+        return std::fflush(file_) == 0;
+    }
+
+    CompactBlockHeader bh{};
+    bh.count = count_;
+    bh.ts_bytes = static_cast<std::uint32_t>(ts_bytes_.size());
+    bh.price_bytes = static_cast<std::uint32_t>(price_bytes_.size());
+    bh.first_epoch_us = first_ts_;
+    bh.first_price = first_price_;
+
+    const std::uint64_t body = sizeof(bh) + ts_bytes_.size() + price_bytes_.size();
+    static constexpr std::uint8_t kZeros[8] = {};
+    bool ok = std::fwrite(&bh, sizeof(bh), 1, file_) == 1;
+    ok = ok && std::fwrite(ts_bytes_.data(), 1, ts_bytes_.size(), file_) == ts_bytes_.size();
+    ok = ok && std::fwrite(price_bytes_.data(), 1, price_bytes_.size(), file_) == price_bytes_.size();
+    ok = ok && std::fwrite(kZeros, 1, padded(body) - body, file_) == padded(body) - body;
+    ok = ok && std::fflush(file_) == 0;
+    if (!ok) {
+        return false;
+    }
+
+    index_.push_back(CompactBlockIndex{first_ts_, last_ts_, offset_, count_});
+    offset_ += padded(body);
+    ticks_ += count_;
+    reset_block();
+    return true;
+}
+
+bool CompactTickWriter::close() {
+    if (file_ == nullptr) {
+        return true;
+    }
+    bool ok = flush();
+    CompactTrailer t{};
+    t.index_offset = offset_;
+    t.block_count = index_.size();
+    t.tick_count = ticks_;
+    std::memcpy(t.magic, kIndexMagic, sizeof(kIndexMagic));
+    ok = ok && std::fwrite(index_.data(), sizeof(CompactBlockIndex), index_.size(), file_) == index_.size();
+    ok = ok && std::fwrite(&t, sizeof(t), 1, file_) == 1;
+    ok = (std::fclose(file_) == 0) && ok;
+    file_ = nullptr;
+    return ok;
+}
+
+// -----------------------------------------------------------------------------
+// Reader
+// -----------------------------------------------------------------------------
+
+CompactTickReader::~CompactTickReader() {
+    close();
+}
+
+bool CompactTickReader::open(const std::string& path) {
+    close();
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st {};
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        return false;
+    }
+    const auto bytes = static_cast<std::size_t>(st.st_size);
+    if (bytes < sizeof(CompactFileHeader)) {
+        ::close(fd);
+        errno = EINVAL;
+        return false;
+    }
+    void* base = ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        return false;
+    }
+    base_ = static_cast<const std::uint8_t*>(base);
+    bytes_ = bytes;
+
+    const CompactFileHeader& h = header();
+    if (std::memcmp(h.magic, kFileMagic, sizeof(kFileMagic)) != 0 || h.version != kVersion) {
+        close();
+        errno = EINVAL;
+        return false;
+    }
+
+    // Closed file: index and trailer at the end.
+    if (bytes_ >= sizeof(CompactFileHeader) + sizeof(CompactTrailer) && open_index()) {
+        return true;
+    }
+
+    // Unclosed file, or an index that does not match the blocks: walk the
+    // self-describing blocks.
+    std::uint64_t pos = sizeof(CompactFileHeader);
+    while (pos + sizeof(CompactBlockHeader) <= bytes_) {
+        CompactBlockHeader bh;
+        std::memcpy(&bh, base_ + pos, sizeof(bh));
+        const std::uint64_t size = padded(sizeof(bh) + std::uint64_t{bh.ts_bytes} + bh.price_bytes);
+        if (bh.count == 0 || pos + size > bytes_) {
+            break;
+        }
+        std::int64_t ts = bh.first_epoch_us;
+        const std::uint8_t* p = base_ + pos + sizeof(bh);
+        const std::uint8_t* end = p + bh.ts_bytes;
+        bool ok = true;
+        for (std::uint32_t i = 1; i < bh.count && ok; ++i) {
+            std::uint64_t v = 0;
+            ok = get_varint(p, end, v);
+            ts = wrap_add(ts, unzigzag(v));
+        }
+        if (!ok) {
+            break;
+        }
+        scanned_.push_back(CompactBlockIndex{bh.first_epoch_us, ts, pos, bh.count});
+        tick_count_ += bh.count;
+        pos += size;
+    }
+    blocks_ = scanned_;
+    data_end_ = pos;
+    return true;
+}
+
+/// Adopts the index and trailer at the end of the mapping if they describe
+/// complete blocks inside the data area whose counts add up to the
+/// trailer's tick_count, so the readers never leave the mapping.
+bool CompactTickReader::open_index() {
+    CompactTrailer t;
+    std::memcpy(&t, base_ + bytes_ - sizeof(t), sizeof(t));
+    const std::uint64_t index_room = bytes_ - sizeof(t) - sizeof(CompactFileHeader);
+    if (std::memcmp(t.magic, kIndexMagic, sizeof(kIndexMagic)) != 0 || t.index_offset % 8 != 0 ||
+        t.index_offset < sizeof(CompactFileHeader) ||
+        t.block_count > index_room / sizeof(CompactBlockIndex) ||
+        t.index_offset + t.block_count * sizeof(CompactBlockIndex) + sizeof(t) != bytes_) {
+        return false;
+    }
+    const auto* index = reinterpret_cast<const CompactBlockIndex*>(base_ + t.index_offset);
+    std::uint64_t ticks = 0;
+    for (std::uint64_t b = 0; b < t.block_count; ++b) {
+        const CompactBlockIndex& e = index[b];
+        if (e.offset < sizeof(CompactFileHeader) || e.offset % 8 != 0 ||
+            e.offset > t.index_offset - sizeof(CompactBlockHeader)) {
+            return false;
+        }
+        CompactBlockHeader bh;
+        std::memcpy(&bh, base_ + e.offset, sizeof(bh));
+        const std::uint64_t size = sizeof(bh) + std::uint64_t{bh.ts_bytes} + bh.price_bytes;
+        if (bh.count == 0 || bh.count != e.count || size > t.index_offset - e.offset) {
+            return false;
+        }
+        ticks += bh.count;
+    }
+    if (ticks != t.tick_count) {
+        return false;
+    }
+    blocks_ = {index, static_cast<std::size_t>(t.block_count)};
+    tick_count_ = t.tick_count;
+    data_end_ = t.index_offset;
+    return true;
+}
+
+void CompactTickReader::close() {
+    if (base_ != nullptr) {
+        ::munmap(const_cast<std::uint8_t*>(base_), bytes_);
+    }
+    base_ = nullptr;
+    bytes_ = 0;
+    blocks_ = {};
+    scanned_.clear();
+    tick_count_ = 0;
+    data_end_ = 0;
+}
+
+const CompactBlockHeader& CompactTickReader::block_header(std::size_t b) const {
+    return *reinterpret_cast<const CompactBlockHeader*>(base_ + blocks_[b].offset);
+}
+
+std::span<const std::uint8_t> CompactTickReader::ts_column(std::size_t b) const {
+    const CompactBlockHeader& bh = block_header(b);
+    return {base_ + blocks_[b].offset + sizeof(bh), bh.ts_bytes};
+}
+
+std::span<const std::uint8_t> CompactTickReader::price_column(std::size_t b) const {
+    const CompactBlockHeader& bh = block_header(b);
+    return {base_ + blocks_[b].offset + sizeof(bh) + bh.ts_bytes, bh.price_bytes};
+}
+
+std::size_t CompactTickReader::decode_block(std::size_t b, std::span<TickRecord> out) const {
+    if (b >= blocks_.size()) {
+        return 0;
+    }
+    const CompactBlockHeader& bh = block_header(b);
+    if (out.size() < bh.count) {
+        return 0;
+    }
+    const double inv_scale = 1.0 / header().price_scale;
+    const std::span<const std::uint8_t> ts_col = ts_column(b);
+    const std::span<const std::uint8_t> px_col = price_column(b);
+    const std::uint8_t* tp = ts_col.data();
+    const std::uint8_t* pp = px_col.data();
+
+    std::int64_t ts = bh.first_epoch_us;
+    std::int64_t px = bh.first_price;
+    out[0] = TickRecord{static_cast<double>(px) * inv_scale, ts};
+    for (std::uint32_t i = 1; i < bh.count; ++i) {
+        std::uint64_t dt = 0;
+        std::uint64_t dp = 0;
+        if (!get_varint(tp, ts_col.data() + ts_col.size(), dt) ||
+            !get_varint(pp, px_col.data() + px_col.size(), dp)) {
+            return 0;
+        }
+        ts = wrap_add(ts, unzigzag(dt));
+        px = wrap_add(px, unzigzag(dp));
+        out[i] = TickRecord{static_cast<double>(px) * inv_scale, ts};
+    }
+    return bh.count;
+}
+
+bool CompactTickReader::decode_all(std::vector<TickRecord>& out) const {
+    std::size_t at = out.size();
+    out.resize(at + static_cast<std::size_t>(tick_count_));
+    for (std::size_t b = 0; b < blocks_.size(); ++b) {
+        const std::size_t n = decode_block(b, std::span<TickRecord>(out).subspan(at));
+        if (n == 0) {
+            out.resize(at);
+            return false;
+        }
+        at += n;
+    }
+    out.resize(at);
+    return true;
+}
+
+bool is_compact_tick_file(const std::string& path) {
+    char magic[sizeof(kFileMagic)] = {};
+    std::FILE* f = std::fopen(path.c_str(), "rb");
+    if (f == nullptr) {
+        return false;
+    }
+    const bool ok = std::fread(magic, 1, sizeof(magic), f) == sizeof(magic);
+    std::fclose(f);
+    return ok && std::memcmp(magic, kFileMagic, sizeof(kFileMagic)) == 0;
+}
+
+}  // namespace merton
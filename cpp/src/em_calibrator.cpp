@@ -0,0 +1,146 @@
+// -----------------------------------------------------------------------------
+// em_calibrator.cpp
+// -----------------------------------------------------------------------------
+//
+// EM engine for the Merton mixture (see em_calibrator.hpp).
+//
+// Complete data per return: jump count N ~ Poisson(lambda*dt), diffusion
+// part D ~ N(drift, sigma^2*dt) and jump sum J | N ~ N(N*mu_j, N*delta_j^2)
+// with x = D + J. Its log-likelihood is maximized in closed form by
+//   lambda    = sum E[N] / sum dt
+//   sigma^2   = sum E[(D - drift)^2] / dt / #returns
+//   mu_j      = sum E[J] / sum E[N]
+//   delta_j^2 = sum E[(J - N*mu_j)^2 / N; N >= 1] / sum P(N >= 1)
+// The drift (-lambda*k - sigma^2/2)*dt is held at the E-step params within an
+// iteration (a generalized EM step); it is O(dt) and far below the tick
+// return scale, and fit() only keeps iterations that lower the exact NLL.
+// -----------------------------------------------------------------------------
+
+#include "em_calibrator.hpp"
+
+#include <algorithm>
+#include <array>
+
+namespace merton {
+
+namespace {
+
+// Below this much posterior jump mass mu_j / delta_j are not re-estimated.
+constexpr double kMinJumpMass = 1e-9;
+
+}  // namespace
+
+EmMertonCalibrator::EmMertonCalibrator(const MertonParams& lower, const MertonParams& upper, EmOptions options)
+    : lower_(lower),
+      upper_(upper),
+      options_(options),
+      decay_(1.0 - 1.0 / static_cast<double>(std::max<std::size_t>(options.memory, 1))) {}
+
+// -----------------------------------------------------------------------------
+// M-step
+// -----------------------------------------------------------------------------
+
+MertonParams EmMertonCalibrator::m_step(const EmSufficientStats& s, const MertonParams& prior) const {
+    MertonParams p = prior;
+    if (s.weight > 0.0 && s.diffusion_sq > 0.0) {
+        p.sigma = std::sqrt(s.diffusion_sq / s.weight);
+    }
+    if (s.time > 0.0) {
+        p.lambda = s.jumps / s.time;
+    }
+    if (s.jump_mass > kMinJumpMass && s.jumps > 0.0) {
+        p.mu_j = s.jump_sum / s.jumps;
+        const double var = (s.jump_sq - p.mu_j * p.mu_j * s.jumps) / s.jump_mass;
+        if (var > 0.0) {
+            p.delta_j = std::sqrt(var);
+        }
+    }
+    return clamp(p);
+}
+
+// -----------------------------------------------------------------------------
+// SQUAREM extrapolation
+// -----------------------------------------------------------------------------
+//
+// Varadhan & Roland's squared iterative method (SqS3 step length) on the two
+// EM steps p0 -> p1 -> p2, in box-normalized coordinates so the four
+// parameters are on one scale:
+//   r = p1 - p0, v = p2 - 2*p1 + p0, alpha = -|r| / |v| (<= -1)
+//   p' = p0 - 2*alpha*r + alpha^2*v
+// alpha = -1 gives back p2; larger |alpha| follows the EM path further where
+// it creeps along a ridge (typically sigma against lambda*delta_j^2).
+// -----------------------------------------------------------------------------
+
+MertonParams EmMertonCalibrator::extrapolate(const MertonParams& p0, const MertonParams& p1,
+                                             const MertonParams& p2) const {
+    const std::array<double, 4> span{upper_.sigma - lower_.sigma, upper_.lambda - lower_.lambda,
+                                     upper_.mu_j - lower_.mu_j, upper_.delta_j - lower_.delta_j};
+    const std::array<double, 4> x0{p0.sigma, p0.lambda, p0.mu_j, p0.delta_j};
+    const std::array<double, 4> x1{p1.sigma, p1.lambda, p1.mu_j, p1.delta_j};
+    const std::array<double, 4> x2{p2.sigma, p2.lambda, p2.mu_j, p2.delta_j};
+
+    std::array<double, 4> r{};
+    std::array<double, 4> v{};
+    double rr = 0.0;
+    double vv = 0.0;
+    for (std::size_t i = 0; i < 4; ++i) {
+        r[i] = (x1[i] - x0[i]) / span[i];
+        v[i] = (x2[i] - 2.0 * x1[i] + x0[i]) / span[i];
+        rr += r[i] * r[i];
+        vv += v[i] * v[i];
+    }
+    if (!(vv > 0.0)) {
+        return p2;
+    }
+    const double alpha = std::min(-1.0, -std::sqrt(rr / vv));
+    std::array<double, 4> out{};
+    for (std::size_t i = 0; i < 4; ++i) {
+        out[i] = x0[i] + span[i] * (-2.0 * alpha * r[i] + alpha * alpha * v[i]);
+    }
+    return clamp(MertonParams{out[0], out[1], out[2], out[3]});
+}
+
+// -----------------------------------------------------------------------------
+// Online EM
+// -----------------------------------------------------------------------------
+//
+// Stochastic-approximation EM: S <- decay * S + s(r) with decay = 1 - 1/memory,
+// so S weights the last ~memory returns. Ratios of S are what the M-step
+// uses, hence no (1 - decay) normalization. Each return is scored under the
+// params current when it arrives.
+// -----------------------------------------------------------------------------
+
+void EmMertonCalibrator::observe(const MixtureTerms& terms, const MertonParams& p, double r, double dt_years) {
+    EmSufficientStats s;
+    const double nll = mixture_em_stats(terms, p, dt_years, std::span<const double>(&r, 1), {}, s);
+    online_.scale(decay_);
+    online_.add(s);
+    online_nll_ = decay_ * online_nll_ + nll;
+}
+
+double EmMertonCalibrator::online_nll_per_return() const {
+    return online_.weight > 0.0 ? online_nll_ / online_.weight : 0.0;
+}
+
+void EmMertonCalibrator::seed_online(const EmSufficientStats& stats, double nll) {
+    online_ = stats;
+    online_nll_ = nll;
+    seeded_ = true;
+}
+
+void EmMertonCalibrator::reset_online() {
+    online_ = EmSufficientStats{};
+    online_nll_ = 0.0;
+    seeded_ = false;
+}
+
+MertonParams EmMertonCalibrator::clamp(const MertonParams& p) const {
+    return MertonParams{
+        std::clamp(p.sigma, lower_.sigma, upper_.sigma),
+        std::clamp(p.lambda, lower_.lambda, upper_.lambda),
+        std::clamp(p.mu_j, lower_.mu_j, upper_.mu_j),
+        std::clamp(p.delta_j, lower_.delta_j, upper_.delta_j),
+    };
+}
+
+}  // namespace merton
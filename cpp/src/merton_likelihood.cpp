@@ -0,0 +1,958 @@
+// -----------------------------------------------------------------------------
+// merton_likelihood.cpp
+// -----------------------------------------------------------------------------
+//
+// Batch evaluation of the Merton log-return density and weighted NLL.
+//
+// The mixture constants (Poisson weights, conditional means, inverse sigmas,
+// Gaussian normalizers) depend only on the candidate params and dt, so they
+// are hoisted into MixtureTerms once per candidate. The per-return loop is
+// then a pure sum of coef_n * exp(-0.5 * ((x - mu_n) * inv_sigma_n)^2),
+// which is vectorized across returns (4 lanes AVX2, 8 lanes AVX-512) with a
+// polynomial exp. The instruction set is selected once at runtime; the
+// scalar path is always available.
+// -----------------------------------------------------------------------------
+
+#include "merton_likelihood.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+#if defined(MERTON_ENABLE_SIMD) && (defined(__x86_64__) || defined(__i386__))
+#define MERTON_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+namespace merton {
+
+namespace {
+
+// 1/sqrt(2*pi) for standard normal PDF: phi(z) = (1/sqrt(2pi)) * exp(-z^2/2)
+constexpr double kInvSqrt2Pi = 0.3989422804014326779399460599343818684759;
+// Density floor so log() stays finite for far-tail returns (direct mode).
+constexpr double kPdfFloor = 1e-300;
+
+// exp(x) for x <= 0: x = k*ln2 + r with |r| <= ln2/2, exp(r) by a Taylor
+// polynomial, then scaled by 2^k. Degree 12 has relative error < 2e-16,
+// degree 8 (MixtureEval::fast) < 3e-10. Arguments below kExpMinArg flush to
+// 0 (std::exp would return a subnormal there, which is far below kPdfFloor
+// anyway).
+constexpr double kExpMinArg = -708.0;
+constexpr double kLog2e = 1.4426950408889634073599;
+constexpr double kLn2 = 6.93147180559945309417e-01;
+constexpr double kLn2Hi = 6.93147180369123816490e-01;
+constexpr double kLn2Lo = 1.90821492927058770002e-10;
+constexpr int kExpDegree = 12;
+constexpr int kFastExpDegree = 8;
+constexpr double kExpPoly[kExpDegree + 1] = {
+    1.0,
+    1.0,
+    1.0 / 2.0,
+    1.0 / 6.0,
+    1.0 / 24.0,
+    1.0 / 120.0,
+    1.0 / 720.0,
+    1.0 / 5040.0,
+    1.0 / 40320.0,
+    1.0 / 362880.0,
+    1.0 / 3628800.0,
+    1.0 / 39916800.0,
+    1.0 / 479001600.0,
+};
+
+constexpr double kSqrt2 = 1.41421356237309504880;
+
+/// Scalar twin of the vector exp_neg kernels (MixtureEval::fast only).
+inline double exp_neg_fast(double x) {
+    if (x < kExpMinArg) {
+        return 0.0;
+    }
+    const double k = std::nearbyint(x * kLog2e);
+    const double r = std::fma(-k, kLn2Lo, std::fma(-k, kLn2Hi, x));
+    double p = kExpPoly[kFastExpDegree];
+    for (int i = kFastExpDegree - 1; i >= 0; --i) {
+        p = std::fma(p, r, kExpPoly[i]);
+    }
+    return p * std::bit_cast<double>(static_cast<std::uint64_t>(static_cast<std::int64_t>(k) + 1023) << 52);
+}
+
+/// log(f) for normal f > 0: f = 2^e * m with m in [sqrt(1/2), sqrt(2)),
+/// log(m) = 2*atanh(s), s = (m-1)/(m+1), |s| < 0.172, by its odd series
+/// through s^9 (absolute error < 1e-9). Only used on log-sum-exp sums, which
+/// are >= 1.
+inline double log_fast(double f) {
+    const auto bits = std::bit_cast<std::uint64_t>(f);
+    auto e = static_cast<std::int64_t>(bits >> 52) - 1023;
+    double m = std::bit_cast<double>((bits & 0x000fffffffffffffull) | 0x3ff0000000000000ull);
+    if (m > kSqrt2) {
+        m *= 0.5;
+        ++e;
+    }
+    const double s = (m - 1.0) / (m + 1.0);
+    const double s2 = s * s;
+    const double series = 2.0 + s2 * (2.0 / 3.0 + s2 * (2.0 / 5.0 + s2 * (2.0 / 7.0 + s2 * (2.0 / 9.0))));
+    return static_cast<double>(e) * kLn2 + s * series;
+}
+
+template <MixtureEval Eval>
+inline double exp_term(double x) {
+    if constexpr (Eval == MixtureEval::fast) {
+        return exp_neg_fast(x);
+    } else {
+        return std::exp(x);
+    }
+}
+
+/// log f(x) of one return from its mixture sum; for the log-sum-exp modes
+/// sum is scaled by exp(-shift) and never below 1, so there is no floor.
+template <MixtureEval Eval>
+inline double log_density(double sum, double shift) {
+    if constexpr (Eval == MixtureEval::direct) {
+        return std::log(std::max(sum, kPdfFloor));
+    } else if constexpr (Eval == MixtureEval::fast) {
+        return shift + log_fast(sum);
+    } else {
+        return shift + std::log(sum);
+    }
+}
+
+using NllKernel = double (*)(const MixtureTerms&, const double*, const double*, std::size_t);
+
+// Parameter sensitivities of the term means / variances (see the fused
+// gradient section below) and the running NLL + gradient sums.
+struct GradientCoefs {
+    double dmean_dsigma;
+    double dmean_dlambda;
+    double dmean_dmu;
+    double dmean_ddelta;
+    double dvar_dsigma;
+    double dvar_n_ddelta;  // d var_n / d delta_j = n * dvar_n_ddelta
+    double dt;
+    double inv_lambda;
+};
+
+struct GradientSums {
+    double nll = 0.0;
+    double sigma = 0.0;
+    double lambda = 0.0;
+    double mu_j = 0.0;
+    double delta_j = 0.0;
+};
+
+using GradKernel = void (*)(const MixtureTerms&, const GradientCoefs&, const double*, const double*, std::size_t,
+                            GradientSums&);
+
+// Per-term constants of the EM posterior moments (see the EM section below).
+struct EmCoefs {
+    std::array<double, MixtureTerms::kMaxTerms> diffusion_share{};  // sigma^2*dt / var_n
+    std::array<double, MixtureTerms::kMaxTerms> post_var{};         // Var[D | n, x] = Var[J | n, x]
+    std::array<double, MixtureTerms::kMaxTerms> jump_mean{};        // n*mu_j
+    std::array<double, MixtureTerms::kMaxTerms> has_jump{};         // n >= 1
+    std::array<double, MixtureTerms::kMaxTerms> inv_jumps{};        // 1/n, 0 for n = 0
+    double inv_dt = 0.0;
+    double dt = 0.0;
+};
+
+using EmKernel = void (*)(const MixtureTerms&, const EmCoefs&, const double*, const double*, std::size_t,
+                          double&, EmSufficientStats&);
+
+// The per-return sums below are all linear in the term densities g_n, so in
+// the log-sum-exp modes they are accumulated from g_n * exp(-shift) and only
+// the NLL needs the shift back; every ratio to f is unchanged.
+
+/// Chain rule for one return from its six per-term sums.
+template <MixtureEval Eval>
+inline void accumulate_gradient(const GradientCoefs& c, double wi, double shift, double f, double f_n, double a,
+                                double a_n, double b, double b_n, GradientSums& out) {
+    if constexpr (Eval == MixtureEval::direct) {
+        if (f <= kPdfFloor) {
+            out.nll -= wi * std::log(kPdfFloor);
+            return;
+        }
+    }
+    out.nll -= wi * log_density<Eval>(f, shift);
+    const double scale = wi / f;
+    out.sigma -= scale * (c.dmean_dsigma * a + c.dvar_dsigma * b);
+    out.lambda -= scale * (f_n * c.inv_lambda - c.dt * f + c.dmean_dlambda * a);
+    out.mu_j -= scale * (c.dmean_dmu * a + a_n);
+    out.delta_j -= scale * (c.dmean_ddelta * a + c.dvar_n_ddelta * b_n);
+}
+
+/// Normalizes one return's six per-term sums by f and adds them to out.
+template <MixtureEval Eval>
+inline void accumulate_em(const EmCoefs& c, double wi, double shift, double f, double f_n, double f_1, double d2,
+                          double j, double j2, double& nll, EmSufficientStats& out) {
+    if constexpr (Eval == MixtureEval::direct) {
+        if (f <= kPdfFloor) {
+            nll -= wi * std::log(kPdfFloor);
+            return;
+        }
+    }
+    nll -= wi * log_density<Eval>(f, shift);
+    const double scale = wi / f;
+    out.weight += wi;
+    out.time += wi * c.dt;
+    out.jumps += scale * f_n;
+    out.jump_mass += scale * f_1;
+    out.diffusion_sq += scale * d2 * c.inv_dt;
+    out.jump_sum += scale * j;
+    out.jump_sq += scale * j2;
+}
+
+/// Term-loop bound of the MertonKernel<NMax> instantiations: a compile-time
+/// constant for NMax > 0 (only dispatched when t.count == NMax), t.count for
+/// the runtime-count kernels.
+template <std::size_t NMax>
+constexpr std::size_t term_count(const MixtureTerms& t) {
+    if constexpr (NMax > 0) {
+        return NMax;
+    } else {
+        return t.count;
+    }
+}
+
+/// Largest log term density log(coef_n) - z_n^2/2 at x (0 in direct mode).
+template <std::size_t NMax, MixtureEval Eval>
+double log_shift_scalar(const MixtureTerms& t, double x) {
+    if constexpr (Eval == MixtureEval::direct) {
+        return 0.0;
+    } else {
+        double shift = -std::numeric_limits<double>::infinity();
+        for (std::size_t k = 0; k < term_count<NMax>(t); ++k) {
+            const double z = (x - t.mean[k]) * t.inv_sigma[k];
+            shift = std::max(shift, t.log_coef[k] - 0.5 * z * z);
+        }
+        return shift;
+    }
+}
+
+/// g_k * exp(-shift) for standardized distance z.
+template <MixtureEval Eval>
+inline double term_density(const MixtureTerms& t, std::size_t k, double z, double shift) {
+    if constexpr (Eval == MixtureEval::direct) {
+        return t.coef[k] * std::exp(-0.5 * z * z);
+    } else {
+        return exp_term<Eval>(t.log_coef[k] - 0.5 * z * z - shift);
+    }
+}
+
+/// Scalar reference: sum over terms with std::exp.
+template <std::size_t NMax>
+double pdf_scalar(const MixtureTerms& t, double x) {
+    double pdf = 0.0;
+    for (std::size_t n = 0; n < term_count<NMax>(t); ++n) {
+        const double z = (x - t.mean[n]) * t.inv_sigma[n];
+        pdf += t.coef[n] * std::exp(-0.5 * z * z);
+    }
+    return std::max(pdf, kPdfFloor);
+}
+
+template <std::size_t NMax, MixtureEval Eval>
+double nll_scalar(const MixtureTerms& t, const double* x, const double* w, std::size_t n) {
+    double nll = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const double wi = w ? w[i] : 1.0;
+        if constexpr (Eval == MixtureEval::direct) {
+            nll -= wi * std::log(pdf_scalar<NMax>(t, x[i]));
+        } else {
+            const double shift = log_shift_scalar<NMax, Eval>(t, x[i]);
+            double sum = 0.0;
+            for (std::size_t k = 0; k < term_count<NMax>(t); ++k) {
+                sum += term_density<Eval>(t, k, (x[i] - t.mean[k]) * t.inv_sigma[k], shift);
+            }
+            nll -= wi * log_density<Eval>(sum, shift);
+        }
+    }
+    return nll;
+}
+
+template <std::size_t NMax, MixtureEval Eval>
+void grad_scalar(const MixtureTerms& t, const GradientCoefs& c, const double* x, const double* w, std::size_t n,
+                 GradientSums& out) {
+    for (std::size_t i = 0; i < n; ++i) {
+        const double shift = log_shift_scalar<NMax, Eval>(t, x[i]);
+        double f = 0.0;
+        double f_n = 0.0;
+        double a = 0.0;
+        double a_n = 0.0;
+        double b = 0.0;
+        double b_n = 0.0;
+        for (std::size_t k = 0; k < term_count<NMax>(t); ++k) {
+            const double z = (x[i] - t.mean[k]) * t.inv_sigma[k];
+            const double g = term_density<Eval>(t, k, z, shift);
+            const double ga = g * z * t.inv_sigma[k];
+            const double gb = 0.5 * g * (z * z - 1.0) * t.inv_sigma[k] * t.inv_sigma[k];
+            f += g;
+            f_n += g * t.jumps[k];
+            a += ga;
+            a_n += ga * t.jumps[k];
+            b += gb;
+            b_n += gb * t.jumps[k];
+        }
+        accumulate_gradient<Eval>(c, w ? w[i] : 1.0, shift, f, f_n, a, a_n, b, b_n, out);
+    }
+}
+
+template <std::size_t NMax, MixtureEval Eval>
+void em_scalar(const MixtureTerms& t, const EmCoefs& c, const double* x, const double* w, std::size_t n,
+               double& nll, EmSufficientStats& out) {
+    for (std::size_t i = 0; i < n; ++i) {
+        const double shift = log_shift_scalar<NMax, Eval>(t, x[i]);
+        double f = 0.0;
+        double f_n = 0.0;
+        double f_1 = 0.0;
+        double d2 = 0.0;
+        double j = 0.0;
+        double j2 = 0.0;
+        for (std::size_t k = 0; k < term_count<NMax>(t); ++k) {
+            const double r = x[i] - t.mean[k];
+            const double z = r * t.inv_sigma[k];
+            const double g = term_density<Eval>(t, k, z, shift);
+            const double d = c.diffusion_share[k] * r;
+            const double jk = c.jump_mean[k] + r - d;
+            f += g;
+            f_n += g * t.jumps[k];
+            f_1 += g * c.has_jump[k];
+            d2 += g * (d * d + c.post_var[k]);
+            j += g * jk;
+            j2 += g * (jk * jk + c.post_var[k]) * c.inv_jumps[k];
+        }
+        accumulate_em<Eval>(c, w ? w[i] : 1.0, shift, f, f_n, f_1, d2, j, j2, nll, out);
+    }
+}
+
+#ifdef MERTON_X86_SIMD
+
+template <int Degree>
+__attribute__((target("avx2,fma")))
+inline __m256d exp_neg_avx2(__m256d x) {
+    const __m256d lo = _mm256_set1_pd(kExpMinArg);
+    const __m256d under = _mm256_cmp_pd(x, lo, _CMP_LT_OQ);
+    x = _mm256_max_pd(x, lo);
+    const __m256d k = _mm256_round_pd(
+        _mm256_mul_pd(x, _mm256_set1_pd(kLog2e)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m256d r = _mm256_fnmadd_pd(k, _mm256_set1_pd(kLn2Hi), x);
+    r = _mm256_fnmadd_pd(k, _mm256_set1_pd(kLn2Lo), r);
+
+    __m256d p = _mm256_set1_pd(kExpPoly[Degree]);
+    for (int i = Degree - 1; i >= 0; --i) {
+        p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(kExpPoly[i]));
+    }
+
+    // 2^k via exponent bits; k is in [-1022, 0] after the clamp above.
+    const __m256i ki = _mm256_cvtepi32_epi64(_mm256_cvtpd_epi32(k));
+    const __m256i bits = _mm256_slli_epi64(_mm256_add_epi64(ki, _mm256_set1_epi64x(1023)), 52);
+    return _mm256_andnot_pd(under, _mm256_mul_pd(p, _mm256_castsi256_pd(bits)));
+}
+
+/// Per-lane log-sum-exp shift (see log_shift_scalar).
+template <std::size_t NMax, MixtureEval Eval>
+__attribute__((target("avx2,fma")))
+inline __m256d log_shift_avx2(const MixtureTerms& t, __m256d xv) {
+    if constexpr (Eval == MixtureEval::direct) {
+        return _mm256_setzero_pd();
+    } else {
+        const __m256d neg_half = _mm256_set1_pd(-0.5);
+        __m256d shift = _mm256_set1_pd(-std::numeric_limits<double>::infinity());
+        for (std::size_t k = 0; k < term_count<NMax>(t); ++k) {
+            const __m256d z = _mm256_mul_pd(
+                _mm256_sub_pd(xv, _mm256_set1_pd(t.mean[k])), _mm256_set1_pd(t.inv_sigma[k]));
+            shift = _mm256_max_pd(shift, _mm256_fmadd_pd(neg_half, _mm256_mul_pd(z, z), _mm256_set1_pd(t.log_coef[k])));
+        }
+        return shift;
+    }
+}
+
+/// g_k * exp(-shift) from z^2 (see term_density).
+template <MixtureEval Eval>
+__attribute__((target("avx2,fma")))
+inline __m256d term_density_avx2(const MixtureTerms& t, std::size_t k, __m256d z2, __m256d shift) {
+    const __m256d neg_half = _mm256_set1_pd(-0.5);
+    if constexpr (Eval == MixtureEval::direct) {
+        return _mm256_mul_pd(_mm256_set1_pd(t.coef[k]), exp_neg_avx2<kExpDegree>(_mm256_mul_pd(neg_half, z2)));
+    } else {
+        constexpr int degree = Eval == MixtureEval::fast ? kFastExpDegree : kExpDegree;
+        return exp_neg_avx2<degree>(_mm256_sub_pd(_mm256_fmadd_pd(neg_half, z2, _mm256_set1_pd(t.log_coef[k])), shift));
+    }
+}
+
+template <std::size_t NMax, MixtureEval Eval>
+__attribute__((target("avx2,fma")))
+double nll_avx2(const MixtureTerms& t, const double* x, const double* w, std::size_t n) {
+    const __m256d neg_half = _mm256_set1_pd(-0.5);
+    alignas(32) double pdf[4];
+    alignas(32) double shifts[4];
+
+    double nll = 0.0;
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256d xv = _mm256_loadu_pd(x + i);
+        const __m256d shift = log_shift_avx2<NMax, Eval>(t, xv);
+        __m256d acc = _mm256_setzero_pd();
+        for (std::size_t k = 0; k < term_count<NMax>(t); ++k) {
+            const __m256d z = _mm256_mul_pd(
+                _mm256_sub_pd(xv, _mm256_set1_pd(t.mean[k])), _mm256_set1_pd(t.inv_sigma[k]));
+            if constexpr (Eval == MixtureEval::direct) {
+                const __m256d e = exp_neg_avx2<kExpDegree>(_mm256_mul_pd(neg_half, _mm256_mul_pd(z, z)));
+                acc = _mm256_fmadd_pd(_mm256_set1_pd(t.coef[k]), e, acc);
+            } else {
+                acc = _mm256_add_pd(acc, term_density_avx2<Eval>(t, k, _mm256_mul_pd(z, z), shift));
+            }
+        }
+        _mm256_store_pd(pdf, acc);
+        _mm256_store_pd(shifts, shift);
+        for (std::size_t j = 0; j < 4; ++j) {
+            nll -= (w ? w[i + j] : 1.0) * log_density<Eval>(pdf[j], shifts[j]);
+        }
+    }
+    return nll + nll_scalar<NMax, Eval>(t, x + i, w ? w + i : nullptr, n - i);
+}
+
+template <int Degree>
+__attribute__((target("avx512f")))
+inline __m512d exp_neg_avx512(__m512d x) {
+    const __m512d lo = _mm512_set1_pd(kExpMinArg);
+    const __mmask8 under = _mm512_cmp_pd_mask(x, lo, _CMP_LT_OQ);
+    x = _mm512_max_pd(x, lo);
+    const __m512d k = _mm512_roundscale_pd(
+        _mm512_mul_pd(x, _mm512_set1_pd(kLog2e)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m512d r = _mm512_fnmadd_pd(k, _mm512_set1_pd(kLn2Hi), x);
+    r = _mm512_fnmadd_pd(k, _mm512_set1_pd(kLn2Lo), r);
+
+    __m512d p = _mm512_set1_pd(kExpPoly[Degree]);
+    for (int i = Degree - 1; i >= 0; --i) {
+        p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(kExpPoly[i]));
+    }
+    return _mm512_maskz_mov_pd(static_cast<__mmask8>(~under), _mm512_scalef_pd(p, k));
+}
+
+template <std::size_t NMax, MixtureEval Eval>
+__attribute__((target("avx512f")))
+inline __m512d log_shift_avx512(const MixtureTerms& t, __m512d xv) {
+    if constexpr (Eval == MixtureEval::direct) {
+        return _mm512_setzero_pd();
+    } else {
+        const __m512d neg_half = _mm512_set1_pd(-0.5);
+        __m512d shift = _mm512_set1_pd(-std::numeric_limits<double>::infinity());
+        for (std::size_t k = 0; k < term_count<NMax>(t); ++k) {
+            const __m512d z = _mm512_mul_pd(
+                _mm512_sub_pd(xv, _mm512_set1_pd(t.mean[k])), _mm512_set1_pd(t.inv_sigma[k]));
+            shift = _mm512_max_pd(shift, _mm512_fmadd_pd(neg_half, _mm512_mul_pd(z, z), _mm512_set1_pd(t.log_coef[k])));
+        }
+        return shift;
+    }
+}
+
+template <MixtureEval Eval>
+__attribute__((target("avx512f")))
+inline __m512d term_density_avx512(const MixtureTerms& t, std::size_t k, __m512d z2, __m512d shift) {
+    const __m512d neg_half = _mm512_set1_pd(-0.5);
+    if constexpr (Eval == MixtureEval::direct) {
+        return _mm512_mul_pd(_mm512_set1_pd(t.coef[k]), exp_neg_avx512<kExpDegree>(_mm512_mul_pd(neg_half, z2)));
+    } else {
+        constexpr int degree = Eval == MixtureEval::fast ? kFastExpDegree : kExpDegree;
+        return exp_neg_avx512<degree>(
+            _mm512_sub_pd(_mm512_fmadd_pd(neg_half, z2, _mm512_set1_pd(t.log_coef[k])), shift));
+    }
+}
+
+template <std::size_t NMax, MixtureEval Eval>
+__attribute__((target("avx512f")))
+double nll_avx512(const MixtureTerms& t, const double* x, const double* w, std::size_t n) {
+    const __m512d neg_half = _mm512_set1_pd(-0.5);
+    alignas(64) double pdf[8];
+    alignas(64) double shifts[8];
+
+    double nll = 0.0;
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m512d xv = _mm512_loadu_pd(x + i);
+        const __m512d shift = log_shift_avx512<NMax, Eval>(t, xv);
+        __m512d acc = _mm512_setzero_pd();
+        for (std::size_t k = 0; k < term_count<NMax>(t); ++k) {
+            const __m512d z = _mm512_mul_pd(
+                _mm512_sub_pd(xv, _mm512_set1_pd(t.mean[k])), _mm512_set1_pd(t.inv_sigma[k]));
+            if constexpr (Eval == MixtureEval::direct) {
+                const __m512d e = exp_neg_avx512<kExpDegree>(_mm512_mul_pd(neg_half, _mm512_mul_pd(z, z)));
+                acc = _mm512_fmadd_pd(_mm512_set1_pd(t.coef[k]), e, acc);
+            } else {
+                acc = _mm512_add_pd(acc, term_density_avx512<Eval>(t, k, _mm512_mul_pd(z, z), shift));
+            }
+        }
+        _mm512_store_pd(pdf, acc);
+        _mm512_store_pd(shifts, shift);
+        for (std::size_t j = 0; j < 8; ++j) {
+            nll -= (w ? w[i + j] : 1.0) * log_density<Eval>(pdf[j], shifts[j]);
+        }
+    }
+    return nll + nll_scalar<NMax, Eval>(t, x + i, w ? w + i : nullptr, n - i);
+}
+
+template <std::size_t NMax, MixtureEval Eval>
+__attribute__((target("avx2,fma")))
+void grad_avx2(const MixtureTerms& t, const GradientCoefs& c, const double* x, const double* w, std::size_t n,
+               GradientSums& out) {
+    const __m256d half = _mm256_set1_pd(0.5);
+    const __m256d one = _mm256_set1_pd(1.0);
+    alignas(32) double sums[7][4];
+
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256d xv = _mm256_loadu_pd(x + i);
+        const __m256d shift = log_shift_avx2<NMax, Eval>(t, xv);
+        __m256d f = _mm256_setzero_pd();
+        __m256d f_n = _mm256_setzero_pd();
+        __m256d a = _mm256_setzero_pd();
+        __m256d a_n = _mm256_setzero_pd();
+        __m256d b = _mm256_setzero_pd();
+        __m256d b_n = _mm256_setzero_pd();
+        for (std::size_t k = 0; k < term_count<NMax>(t); ++k) {
+            const __m256d is = _mm256_set1_pd(t.inv_sigma[k]);
+            const __m256d jn = _mm256_set1_pd(t.jumps[k]);
+            const __m256d z = _mm256_mul_pd(_mm256_sub_pd(xv, _mm256_set1_pd(t.mean[k])), is);
+            const __m256d z2 = _mm256_mul_pd(z, z);
+            const __m256d g = term_density_avx2<Eval>(t, k, z2, shift);
+            const __m256d ga = _mm256_mul_pd(_mm256_mul_pd(g, z), is);
+            const __m256d gb = _mm256_mul_pd(_mm256_mul_pd(_mm256_mul_pd(half, g), _mm256_sub_pd(z2, one)),
+                                             _mm256_mul_pd(is, is));
+            f = _mm256_add_pd(f, g);
+            f_n = _mm256_fmadd_pd(g, jn, f_n);
+            a = _mm256_add_pd(a, ga);
+            a_n = _mm256_fmadd_pd(ga, jn, a_n);
+            b = _mm256_add_pd(b, gb);
+            b_n = _mm256_fmadd_pd(gb, jn, b_n);
+        }
+        _mm256_store_pd(sums[0], f);
+        _mm256_store_pd(sums[1], f_n);
+        _mm256_store_pd(sums[2], a);
+        _mm256_store_pd(sums[3], a_n);
+        _mm256_store_pd(sums[4], b);
+        _mm256_store_pd(sums[5], b_n);
+        _mm256_store_pd(sums[6], shift);
+        for (std::size_t j = 0; j < 4; ++j) {
+            accumulate_gradient<Eval>(c, w ? w[i + j] : 1.0, sums[6][j], sums[0][j], sums[1][j], sums[2][j],
+                                      sums[3][j], sums[4][j], sums[5][j], out);
+        }
+    }
+    grad_scalar<NMax, Eval>(t, c, x + i, w ? w + i : nullptr, n - i, out);
+}
+
+template <std::size_t NMax, MixtureEval Eval>
+__attribute__((target("avx512f")))
+void grad_avx512(const MixtureTerms& t, const GradientCoefs& c, const double* x, const double* w, std::size_t n,
+                 GradientSums& out) {
+    const __m512d half = _mm512_set1_pd(0.5);
+    const __m512d one = _mm512_set1_pd(1.0);
+    alignas(64) double sums[7][8];
+
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m512d xv = _mm512_loadu_pd(x + i);
+        const __m512d shift = log_shift_avx512<NMax, Eval>(t, xv);
+        __m512d f = _mm512_setzero_pd();
+        __m512d f_n = _mm512_setzero_pd();
+        __m512d a = _mm512_setzero_pd();
+        __m512d a_n = _mm512_setzero_pd();
+        __m512d b = _mm512_setzero_pd();
+        __m512d b_n = _mm512_setzero_pd();
+        for (std::size_t k = 0; k < term_count<NMax>(t); ++k) {
+            const __m512d is = _mm512_set1_pd(t.inv_sigma[k]);
+            const __m512d jn = _mm512_set1_pd(t.jumps[k]);
+            const __m512d z = _mm512_mul_pd(_mm512_sub_pd(xv, _mm512_set1_pd(t.mean[k])), is);
+            const __m512d z2 = _mm512_mul_pd(z, z);
+            const __m512d g = term_density_avx512<Eval>(t, k, z2, shift);
+            const __m512d ga = _mm512_mul_pd(_mm512_mul_pd(g, z), is);
+            const __m512d gb = _mm512_mul_pd(_mm512_mul_pd(_mm512_mul_pd(half, g), _mm512_sub_pd(z2, one)),
+                                             _mm512_mul_pd(is, is));
+            f = _mm512_add_pd(f, g);
+            f_n = _mm512_fmadd_pd(g, jn, f_n);
+            a = _mm512_add_pd(a, ga);
+            a_n = _mm512_fmadd_pd(ga, jn, a_n);
+            b = _mm512_add_pd(b, gb);
+            b_n = _mm512_fmadd_pd(gb, jn, b_n);
+        }
+        _mm512_store_pd(sums[0], f);
+        _mm512_store_pd(sums[1], f_n);
+        _mm512_store_pd(sums[2], a);
+        _mm512_store_pd(sums[3], a_n);
+        _mm512_store_pd(sums[4], b);
+        _mm512_store_pd(sums[5], b_n);
+        _mm512_store_pd(sums[6], shift);
+        for (std::size_t j = 0; j < 8; ++j) {
+            accumulate_gradient<Eval>(c, w ? w[i + j] : 1.0, sums[6][j], sums[0][j], sums[1][j], sums[2][j],
+                                      sums[3][j], sums[4][j], sums[5][j], out);
+        }
+    }
+    grad_scalar<NMax, Eval>(t, c, x + i, w ? w + i : nullptr, n - i, out);
+}
+
+template <std::size_t NMax, MixtureEval Eval>
+__attribute__((target("avx2,fma")))
+void em_avx2(const MixtureTerms& t, const EmCoefs& c, const double* x, const double* w, std::size_t n,
+             double& nll, EmSufficientStats& out) {
+    alignas(32) double sums[7][4];
+
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256d xv = _mm256_loadu_pd(x + i);
+        const __m256d shift = log_shift_avx2<NMax, Eval>(t, xv);
+        __m256d f = _mm256_setzero_pd();
+        __m256d f_n = _mm256_setzero_pd();
+        __m256d f_1 = _mm256_setzero_pd();
+        __m256d d2 = _mm256_setzero_pd();
+        __m256d j = _mm256_setzero_pd();
+        __m256d j2 = _mm256_setzero_pd();
+        for (std::size_t k = 0; k < term_count<NMax>(t); ++k) {
+            const __m256d pv = _mm256_set1_pd(c.post_var[k]);
+            const __m256d r = _mm256_sub_pd(xv, _mm256_set1_pd(t.mean[k]));
+            const __m256d z = _mm256_mul_pd(r, _mm256_set1_pd(t.inv_sigma[k]));
+            const __m256d g = term_density_avx2<Eval>(t, k, _mm256_mul_pd(z, z), shift);
+            const __m256d d = _mm256_mul_pd(_mm256_set1_pd(c.diffusion_share[k]), r);
+            const __m256d jk = _mm256_add_pd(_mm256_set1_pd(c.jump_mean[k]), _mm256_sub_pd(r, d));
+            f = _mm256_add_pd(f, g);
+            f_n = _mm256_fmadd_pd(g, _mm256_set1_pd(t.jumps[k]), f_n);
+            f_1 = _mm256_fmadd_pd(g, _mm256_set1_pd(c.has_jump[k]), f_1);
+            d2 = _mm256_fmadd_pd(g, _mm256_fmadd_pd(d, d, pv), d2);
+            j = _mm256_fmadd_pd(g, jk, j);
+            j2 = _mm256_fmadd_pd(_mm256_mul_pd(g, _mm256_fmadd_pd(jk, jk, pv)), _mm256_set1_pd(c.inv_jumps[k]), j2);
+        }
+        _mm256_store_pd(sums[0], f);
+        _mm256_store_pd(sums[1], f_n);
+        _mm256_store_pd(sums[2], f_1);
+        _mm256_store_pd(sums[3], d2);
+        _mm256_store_pd(sums[4], j);
+        _mm256_store_pd(sums[5], j2);
+        _mm256_store_pd(sums[6], shift);
+        for (std::size_t l = 0; l < 4; ++l) {
+            accumulate_em<Eval>(c, w ? w[i + l] : 1.0, sums[6][l], sums[0][l], sums[1][l], sums[2][l], sums[3][l],
+                                sums[4][l], sums[5][l], nll, out);
+        }
+    }
+    em_scalar<NMax, Eval>(t, c, x + i, w ? w + i : nullptr, n - i, nll, out);
+}
+
+template <std::size_t NMax, MixtureEval Eval>
+__attribute__((target("avx512f")))
+void em_avx512(const MixtureTerms& t, const EmCoefs& c, const double* x, const double* w, std::size_t n,
+               double& nll, EmSufficientStats& out) {
+    alignas(64) double sums[7][8];
+
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m512d xv = _mm512_loadu_pd(x + i);
+        const __m512d shift = log_shift_avx512<NMax, Eval>(t, xv);
+        __m512d f = _mm512_setzero_pd();
+        __m512d f_n = _mm512_setzero_pd();
+        __m512d f_1 = _mm512_setzero_pd();
+        __m512d d2 = _mm512_setzero_pd();
+        __m512d j = _mm512_setzero_pd();
+        __m512d j2 = _mm512_setzero_pd();
+        for (std::size_t k = 0; k < term_count<NMax>(t); ++k) {
+            const __m512d pv = _mm512_set1_pd(c.post_var[k]);
+            const __m512d r = _mm512_sub_pd(xv, _mm512_set1_pd(t.mean[k]));
+            const __m512d z = _mm512_mul_pd(r, _mm512_set1_pd(t.inv_sigma[k]));
+            const __m512d g = term_density_avx512<Eval>(t, k, _mm512_mul_pd(z, z), shift);
+            const __m512d d = _mm512_mul_pd(_mm512_set1_pd(c.diffusion_share[k]), r);
+            const __m512d jk = _mm512_add_pd(_mm512_set1_pd(c.jump_mean[k]), _mm512_sub_pd(r, d));
+            f = _mm512_add_pd(f, g);
+            f_n = _mm512_fmadd_pd(g, _mm512_set1_pd(t.jumps[k]), f_n);
+            f_1 = _mm512_fmadd_pd(g, _mm512_set1_pd(c.has_jump[k]), f_1);
+            d2 = _mm512_fmadd_pd(g, _mm512_fmadd_pd(d, d, pv), d2);
+            j = _mm512_fmadd_pd(g, jk, j);
+            j2 = _mm512_fmadd_pd(_mm512_mul_pd(g, _mm512_fmadd_pd(jk, jk, pv)), _mm512_set1_pd(c.inv_jumps[k]), j2);
+        }
+        _mm512_store_pd(sums[0], f);
+        _mm512_store_pd(sums[1], f_n);
+        _mm512_store_pd(sums[2], f_1);
+        _mm512_store_pd(sums[3], d2);
+        _mm512_store_pd(sums[4], j);
+        _mm512_store_pd(sums[5], j2);
+        _mm512_store_pd(sums[6], shift);
+        for (std::size_t l = 0; l < 8; ++l) {
+            accumulate_em<Eval>(c, w ? w[i + l] : 1.0, sums[6][l], sums[0][l], sums[1][l], sums[2][l], sums[3][l],
+                                sums[4][l], sums[5][l], nll, out);
+        }
+    }
+    em_scalar<NMax, Eval>(t, c, x + i, w ? w + i : nullptr, n - i, nll, out);
+}
+
+#endif  // MERTON_X86_SIMD
+
+using PdfKernel = double (*)(const MixtureTerms&, double);
+
+struct KernelSet {
+    PdfKernel pdf;
+    NllKernel fn;
+    GradKernel grad;
+    EmKernel em;
+};
+
+// Kernel family for mixtures of exactly NMax terms (NMax = 0: any count),
+// one set per MixtureEval mode. The density kernel is always the direct sum.
+template <std::size_t NMax>
+struct MertonKernel {
+    template <MixtureEval Eval>
+    static constexpr KernelSet scalar{&pdf_scalar<NMax>, &nll_scalar<NMax, Eval>, &grad_scalar<NMax, Eval>,
+                                      &em_scalar<NMax, Eval>};
+#ifdef MERTON_X86_SIMD
+    template <MixtureEval Eval>
+    static constexpr KernelSet avx2{&pdf_scalar<NMax>, &nll_avx2<NMax, Eval>, &grad_avx2<NMax, Eval>,
+                                    &em_avx2<NMax, Eval>};
+    template <MixtureEval Eval>
+    static constexpr KernelSet avx512{&pdf_scalar<NMax>, &nll_avx512<NMax, Eval>, &grad_avx512<NMax, Eval>,
+                                      &em_avx512<NMax, Eval>};
+#endif
+};
+
+// One slot per kMixtureKernelWidths entry, then the runtime-count kernels.
+constexpr std::size_t kKernelSlots = kMixtureKernelWidths.size() + 1;
+using KernelTable = std::array<KernelSet, kKernelSlots>;
+constexpr std::size_t kEvalModes = 3;
+
+/// Instantiates pick.operator()<NMax, Eval>() for every specialized width plus NMax = 0.
+template <MixtureEval Eval, typename Pick, std::size_t... I>
+KernelTable kernel_table(Pick pick, std::index_sequence<I...>) {
+    return {pick.template operator()<static_cast<std::size_t>(kMixtureKernelWidths[I]), Eval>()...,
+            pick.template operator()<0, Eval>()};
+}
+
+template <typename Pick>
+std::array<KernelTable, kEvalModes> kernel_tables(Pick pick) {
+    constexpr auto widths = std::make_index_sequence<kMixtureKernelWidths.size()>{};
+    return {kernel_table<MixtureEval::direct>(pick, widths), kernel_table<MixtureEval::log_sum_exp>(pick, widths),
+            kernel_table<MixtureEval::fast>(pick, widths)};
+}
+
+std::size_t kernel_slot(MixtureKernelWidth width) {
+    for (std::size_t i = 0; i < kMixtureKernelWidths.size(); ++i) {
+        if (kMixtureKernelWidths[i] == width) {
+            return i;
+        }
+    }
+    return kKernelSlots - 1;
+}
+
+struct KernelChoice {
+    std::array<KernelTable, kEvalModes> by_eval;
+    std::string_view isa;
+
+    const KernelSet& operator[](const MixtureTerms& t) const {
+        return by_eval[static_cast<std::size_t>(t.eval)][kernel_slot(t.width)];
+    }
+};
+
+KernelChoice select_kernel() {
+#ifdef MERTON_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return {kernel_tables([]<std::size_t N, MixtureEval E>() { return MertonKernel<N>::template avx512<E>; }),
+                "avx512"};
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return {kernel_tables([]<std::size_t N, MixtureEval E>() { return MertonKernel<N>::template avx2<E>; }),
+                "avx2"};
+    }
+#endif
+    return {kernel_tables([]<std::size_t N, MixtureEval E>() { return MertonKernel<N>::template scalar<E>; }),
+            "scalar"};
+}
+
+const KernelChoice& kernel() {
+    static const KernelChoice choice = select_kernel();
+    return choice;
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+// Mixture constants
+// -----------------------------------------------------------------------------
+//
+// f(x) = sum_{n=0}^{n_max-1} P(N=n) * phi((x - mu_n) / sigma_n) / sigma_n
+// where:
+//   drift = (-lambda*k - 0.5*sigma^2)*dt
+//   mu_n = drift + n*mu_j
+//   var_n = sigma^2*dt + n*delta_j^2
+//   P(N=n) = exp(-lambda*dt) * (lambda*dt)^n / n!
+//
+// P(N=n) is built by the recurrence P(n) = P(n-1) * lambda_dt / n, so the
+// whole table costs one exp plus O(n_max) multiplies. Terms with var_n <= 0
+// are dropped.
+//
+// Adaptive truncation: the running mass sum_{m<=n} P(N=m) is tracked and the
+// table ends once 1 - mass < tail_eps. For lambda_dt ~ 1e-6 (20 jumps/year,
+// second-scale ticks) and tail_eps = 1e-12 that is n = 1, i.e. 2 terms
+// instead of n_max, and the truncation is decided once per candidate.
+//
+// The log-space modes also keep log(coef_n) = log P(N=n) - log(sqrt(2pi)*sigma_n),
+// with log P(N=n) by the same recurrence in logs, so it stays finite where
+// P(N=n) itself would underflow. Per return they evaluate
+//   log f(x) = s + log sum_n exp(log(coef_n) - z_n^2/2 - s),  s = max_n (...)
+// where the largest term is exp(0) = 1, so the sum never underflows: a
+// 30-sigma jump return scores its true log density instead of log(1e-300).
+// That costs one extra pass over the terms for s; fast mode shortens the exp
+// polynomial (degree 8) and replaces std::log by a 5-term atanh series.
+// -----------------------------------------------------------------------------
+
+double jump_compensator(double mu_j, double delta_j) {
+    return std::exp(mu_j + 0.5 * delta_j * delta_j) - 1.0;
+}
+
+MixtureTerms make_mixture_terms(const MertonParams& p, double dt_years, std::size_t n_max, double tail_eps,
+                                MixtureEval eval) {
+    const double lambda_dt = p.lambda * dt_years;
+    const double k = jump_compensator(p.mu_j, p.delta_j);
+    const double drift = (-p.lambda * k - 0.5 * p.sigma * p.sigma) * dt_years;
+    const double diffusion_var = p.sigma * p.sigma * dt_years;
+
+    MixtureTerms t;
+    t.eval = eval;
+    const bool log_space = eval != MixtureEval::direct;
+    const double log_lambda_dt = log_space ? std::log(lambda_dt) : 0.0;
+    const std::size_t n_terms = std::min(n_max, MixtureTerms::kMaxTerms);
+    double weight = std::exp(-lambda_dt);
+    double log_weight = -lambda_dt;
+    double mass = 0.0;
+    for (std::size_t n = 0; n < n_terms; ++n) {
+        if (n > 0) {
+            if (tail_eps > 0.0 && 1.0 - mass < tail_eps) {
+                break;
+            }
+            weight *= lambda_dt / static_cast<double>(n);
+            if (log_space) {
+                log_weight += log_lambda_dt - std::log(static_cast<double>(n));
+            }
+        }
+        mass += weight;
+        const double var_n = diffusion_var + static_cast<double>(n) * p.delta_j * p.delta_j;
+        if (var_n <= 0.0) {
+            continue;
+        }
+        const double inv_sigma_n = 1.0 / std::sqrt(var_n);
+        t.mean[t.count] = drift + static_cast<double>(n) * p.mu_j;
+        t.inv_sigma[t.count] = inv_sigma_n;
+        t.coef[t.count] = weight * kInvSqrt2Pi * inv_sigma_n;
+        t.jumps[t.count] = static_cast<double>(n);
+        if (log_space) {
+            t.log_coef[t.count] = log_weight + std::log(kInvSqrt2Pi) - 0.5 * std::log(var_n);
+        }
+        ++t.count;
+    }
+    t.width = mixture_kernel_width(t.count);
+    return t;
+}
+
+// -----------------------------------------------------------------------------
+// Density and NLL
+// -----------------------------------------------------------------------------
+
+double mixture_pdf(const MixtureTerms& terms, double x) {
+    return kernel()[terms].pdf(terms, x);
+}
+
+double mixture_nll(const MixtureTerms& terms, std::span<const double> x, std::span<const double> w) {
+    const double* wp = w.empty() ? nullptr : w.data();
+    return kernel()[terms].fn(terms, x.data(), wp, x.size());
+}
+
+// -----------------------------------------------------------------------------
+// Fused NLL + gradient
+// -----------------------------------------------------------------------------
+//
+// With g_n = P(N=n) * phi(z_n) / sigma_n, z_n = (x - mu_n) / sigma_n:
+//   d log g_n = d log P(N=n) + (x - mu_n)/var_n * d mu_n
+//             + 0.5 * (z_n^2 - 1)/var_n * d var_n
+// and
+//   d log P(N=n)/d lambda = n/lambda - dt
+//   d mu_n  = -sigma*dt dsigma - k*dt dlambda
+//             + (n - lambda*dt*(k+1)) dmu_j - lambda*dt*(k+1)*delta_j ddelta_j
+//   d var_n = 2*sigma*dt dsigma + 2*n*delta_j ddelta_j
+//
+// so per return only six sums over terms are needed (f, sum n*g, and the
+// mean/variance sensitivities with and without the factor n); the parameter
+// chain rule is applied once per return. Floored densities contribute no
+// gradient. Vectorized and dispatched like mixture_nll.
+// -----------------------------------------------------------------------------
+
+double mixture_nll_gradient(const MixtureTerms& terms, const MertonParams& p, double dt_years,
+                            std::span<const double> x, std::span<const double> w, MertonParams& grad) {
+    const double k1 = jump_compensator(p.mu_j, p.delta_j) + 1.0;
+    GradientCoefs c;
+    c.dmean_dsigma = -p.sigma * dt_years;
+    c.dmean_dlambda = -(k1 - 1.0) * dt_years;
+    c.dmean_dmu = -p.lambda * dt_years * k1;
+    c.dmean_ddelta = c.dmean_dmu * p.delta_j;
+    c.dvar_dsigma = 2.0 * p.sigma * dt_years;
+    c.dvar_n_ddelta = 2.0 * p.delta_j;
+    c.dt = dt_years;
+    c.inv_lambda = p.lambda > 0.0 ? 1.0 / p.lambda : 0.0;
+
+    GradientSums sums;
+    kernel()[terms].grad(terms, c, x.data(), w.empty() ? nullptr : w.data(), x.size(), sums);
+    grad = MertonParams{sums.sigma, sums.lambda, sums.mu_j, sums.delta_j};
+    return sums.nll;
+}
+
+// -----------------------------------------------------------------------------
+// EM sufficient statistics
+// -----------------------------------------------------------------------------
+//
+// Given N = n and x, with r_n = x - mu_n, s2 = sigma^2*dt, var_n = s2 + n*delta_j^2,
+// the diffusion and jump parts of x are jointly Gaussian with
+//   E[D - drift | n, x] = a_n * r_n,          a_n = s2 / var_n
+//   E[J | n, x]         = n*mu_j + (1 - a_n) * r_n
+//   Var[D | n, x] = Var[J | n, x] = s2 * n*delta_j^2 / var_n
+// and P(N = n | x) = g_n / f. So besides f only five sums over terms are
+// needed per return (g_n times n, [n >= 1], E[(D - drift)^2], E[J], E[J^2]/n),
+// computed in the same vectorized loop shape as the NLL.
+// -----------------------------------------------------------------------------
+
+void EmSufficientStats::add(const EmSufficientStats& o) {
+    weight += o.weight;
+    time += o.time;
+    jumps += o.jumps;
+    jump_mass += o.jump_mass;
+    diffusion_sq += o.diffusion_sq;
+    jump_sum += o.jump_sum;
+    jump_sq += o.jump_sq;
+}
+
+void EmSufficientStats::scale(double s) {
+    weight *= s;
+    time *= s;
+    jumps *= s;
+    jump_mass *= s;
+    diffusion_sq *= s;
+    jump_sum *= s;
+    jump_sq *= s;
+}
+
+double mixture_em_stats(const MixtureTerms& terms, const MertonParams& p, double dt_years,
+                        std::span<const double> x, std::span<const double> w, EmSufficientStats& stats) {
+    const double s2 = p.sigma * p.sigma * dt_years;
+    EmCoefs c;
+    c.dt = dt_years;
+    c.inv_dt = dt_years > 0.0 ? 1.0 / dt_years : 0.0;
+    for (std::size_t k = 0; k < terms.count; ++k) {
+        const double n = terms.jumps[k];
+        const double share = s2 * terms.inv_sigma[k] * terms.inv_sigma[k];
+        c.diffusion_share[k] = share;
+        c.post_var[k] = s2 * (1.0 - share);
+        c.jump_mean[k] = n * p.mu_j;
+        c.has_jump[k] = n > 0.0 ? 1.0 : 0.0;
+        c.inv_jumps[k] = n > 0.0 ? 1.0 / n : 0.0;
+    }
+    double nll = 0.0;
+    kernel()[terms].em(terms, c, x.data(), w.empty() ? nullptr : w.data(), x.size(), nll, stats);
+    return nll;
+}
+
+std::string_view mixture_kernel_isa() {
+    return kernel().isa;
+}
+
+}  // namespace merton
@@ -14,22 +14,27 @@
 // Flow:
 //   1. update_tick(price, ts_us): ingest ticks, compute log returns, roll buffer
 //   2. maybe_update_params(): gated MLE coordinate search over rolling returns
+//      (NLL evaluated over the window histogram of distinct returns)
 //   3. fair_value(s0, q, T, r): E[S_T] = S0 * exp((r - q - lambda*k)*T)
+//
+// Threading: params are always published through a seqlock, so params() and
+// fair_value() are safe from any thread. With config.async_recalibration the
+// window and search state are owned by a background worker; update_tick only
+// validates the tick and pushes (r, dt_us) into an SPSC queue.
 // -----------------------------------------------------------------------------
 
 #include "merton_online_calibrator.hpp"
+#include "box_lbfgs.hpp"
+#include "merton_likelihood.hpp"
+#include "quantlib_curves.hpp"
+#include "sobol_sequence.hpp"
 
 #include <algorithm>
+#include <array>
+#include <chrono>
 #include <cmath>
 #include <limits>
-
-#include <ql/handle.hpp>
-#include <ql/settings.hpp>
-#include <ql/shared_ptr.hpp>
-#include <ql/termstructures/yield/flatforward.hpp>
-#include <ql/termstructures/yieldtermstructure.hpp>
-#include <ql/time/date.hpp>
-#include <ql/time/daycounters/actual365fixed.hpp>
+#include <utility>
 
 namespace merton {
 
@@ -37,38 +42,36 @@ namespace {
 
 // Seconds in one year (used to convert dt_us -> dt_years).
 constexpr double kSecsPerYear = 365.25 * 24.0 * 3600.0;
-// 1/sqrt(2*pi) for standard normal PDF: phi(z) = (1/sqrt(2pi)) * exp(-z^2/2)
-constexpr double kInvSqrt2Pi = 0.3989422804014326779399460599343818684759;
+// Worker idle backoff: yield this many empty polls, then sleep.
+constexpr unsigned kWorkerSpinPolls = 64;
+constexpr auto kWorkerIdleSleep = std::chrono::microseconds(200);
 
-/// Guards against log(0) or log(negative); clamps to kFloor before log.
-double safe_log(double x) {
-    constexpr double kFloor = 1e-300;
-    return std::log(std::max(x, kFloor));
+/// Adaptive coordinate-search step sizes: percentage of p with floors.
+MertonParams initial_steps(const MertonParams& p) {
+    return MertonParams{
+        std::max(0.02, p.sigma * 0.08),
+        std::max(0.10, p.lambda * 0.10),
+        std::max(0.002, std::abs(p.mu_j) * 0.25),
+        std::max(0.002, p.delta_j * 0.20),
+    };
 }
 
-/// Jump compensator k = E[J-1] = exp(mu_j + 0.5*delta_j^2) - 1.
-/// Used in drift and in fair-value formula.
-double jump_compensator(double mu_j, double delta_j) {
-    return std::exp(mu_j + 0.5 * delta_j * delta_j) - 1.0;
+void halve_steps(MertonParams& step) {
+    step.sigma *= 0.5;
+    step.lambda *= 0.5;
+    step.mu_j *= 0.5;
+    step.delta_j *= 0.5;
 }
 
-/// Standard normal PDF phi(z) = (1/sqrt(2pi)) * exp(-z^2/2).
-double standard_normal_pdf(double z) {
-    return kInvSqrt2Pi * std::exp(-0.5 * z * z);
+EmOptions em_options(const CalibratorConfig& config) {
+    return EmOptions{config.em_iterations, config.improvement_tol, config.window_size};
 }
 
-/// Poisson weight for n jumps in interval of length lambda_dt:
-///   w_n = exp(-lambda_dt) * (lambda_dt)^n / n!
-/// Computed incrementally to avoid factorial overflow.
-double poisson_weight(std::size_t n, double lambda_dt) {
-    if (n == 0) {
-        return std::exp(-lambda_dt);
-    }
-    double w = std::exp(-lambda_dt);
-    for (std::size_t i = 1; i <= n; ++i) {
-        w *= lambda_dt / static_cast<double>(i);
-    }
-    return w;
+SgdOptions sgd_options(const CalibratorConfig& config) {
+    SgdOptions options;
+    options.learning_rate = config.sgd_learning_rate;
+    options.memory = config.window_size;
+    return options;
 }
 
 }  // namespace
@@ -78,60 +81,366 @@ double poisson_weight(std::size_t n, double lambda_dt) {
 // -----------------------------------------------------------------------------
 
 OnlineMertonCalibrator::OnlineMertonCalibrator(MertonParams initial, CalibratorConfig config)
-    : params_(clamp_params(initial)), config_(config) {}
+    : params_(clamp_params(initial)),
+      config_(config),
+      filter_(config),
+      window_(config.window_size),
+      histogram_(config.return_quantum, config.heterogeneous_dt ? 0 : config.window_size),
+      em_(kParamLower, kParamUpper, em_options(config)),
+      sgd_(kParamLower, kParamUpper, sgd_options(config)),
+      ql_curves_(std::make_unique<QuantLibCarryCurves>()) {
+    publish();
+    last_polled_version_ = published_.version();
+    config_.dt_bucket_sub_bits = std::min(config_.dt_bucket_sub_bits, kMaxDtBucketSubBits);
+    if (config_.heterogeneous_dt) {
+        dt_histogram_ = std::make_unique<DtBucketedHistogram>(config_.return_quantum, config_.dt_bucket_sub_bits);
+    }
+    init_components();
+}
+
+/// (Re)creates the config-dependent threads and buffers: the search pool
+/// (jacobi rounds, global search), the global-search population and the
+/// async queue + worker. The worker must be stopped.
+void OnlineMertonCalibrator::init_components() {
+    search_pool_.reset();
+    if (config_.search_mode == SearchMode::jacobi || config_.global_search_starts > 0) {
+        // The caller thread evaluates candidates too, hence one helper fewer.
+        const std::size_t hw = std::max(1u, std::thread::hardware_concurrency());
+        const std::size_t threads = config_.search_threads > 0 ? config_.search_threads : std::min<std::size_t>(8, hw);
+        if (threads > 1) {
+            search_pool_ = std::make_unique<ThreadPool>(threads - 1);
+        }
+    }
+    // Sobol starts plus the incumbent.
+    const std::size_t population = config_.global_search_starts > 0 ? config_.global_search_starts + 1 : 0;
+    global_candidates_.assign(population, MertonParams{});
+    global_nll_.assign(population, 0.0);
+    // A new buffer rather than a resize, so views of the old one stay valid.
+    if (!log_likelihood_ || log_likelihood_->size() < config_.window_size) {
+        log_likelihood_ = std::make_shared<std::vector<double>>(config_.window_size);
+    }
+    dt_scratch_.resize(config_.window_size);
+    queue_.reset();
+    if (config_.async_recalibration) {
+        queue_ = std::make_unique<SpscQueue<PendingReturn>>(config_.async_queue_capacity);
+        start_worker();
+    }
+}
+
+/// Fresh EM and SGD engines (online statistics included) for the current config_.
+void OnlineMertonCalibrator::reset_engines() {
+    em_ = EmMertonCalibrator(kParamLower, kParamUpper, em_options(config_));
+    sgd_ = SgdMertonCalibrator(kParamLower, kParamUpper, sgd_options(config_));
+}
+
+void OnlineMertonCalibrator::start_worker() {
+    stop_.store(false, std::memory_order_relaxed);
+    worker_ = std::thread([this] { worker_loop(); });
+}
+
+/// Joins the worker (if any) and hands its queue back to the caller thread.
+void OnlineMertonCalibrator::stop_worker() {
+    if (!worker_.joinable()) {
+        return;
+    }
+    stop_.store(true, std::memory_order_release);
+    worker_.join();
+}
+
+OnlineMertonCalibrator::~OnlineMertonCalibrator() {
+    stop_worker();
+}
 
 // -----------------------------------------------------------------------------
 // Tick ingestion
 // -----------------------------------------------------------------------------
 //
 // Pushes a new (price, timestamp) pair into the calibrator. On success:
+//   - Passes it through the tick prefilter (tick_filter.hpp), which may drop
+//     it or hand on an earlier tick instead (time-bar close)
 //   - Computes log return r = log(price / last_price)
-//   - Appends (r, dt_us) to rolling buffers
-//   - Trims to window_size (FIFO)
-//   - Increments returns_since_last_update_ for gating maybe_update_params()
+//   - Sync mode: append_return(r, dt_us) directly
+//   - Async mode: pushes (r, dt_us) to the worker queue
 //
-// Returns true iff a valid return was appended. Returns false if:
+// Returns true iff a valid return was appended (or queued). Returns false if:
 //   - price <= 0
 //   - first tick (no previous price)
 //   - dt_us <= 0 (duplicate or backwards time)
 //   - r not finite (e.g. zero price)
+//   - async queue full (return dropped)
+//   - the prefilter dropped or held the tick
+// update_trade is the same with the print's volume for volume bars.
 // -----------------------------------------------------------------------------
 
 bool OnlineMertonCalibrator::update_tick(double price, std::int64_t epoch_us) {
-    if (!(price > 0.0)) {
+    return ingest(price, epoch_us, 1.0);
+}
+
+bool OnlineMertonCalibrator::update_trade(double price, std::int64_t epoch_us, double volume) {
+    return ingest(price, epoch_us, volume);
+}
+
+bool OnlineMertonCalibrator::ingest(double price, std::int64_t epoch_us, double volume) {
+    AllocationScope alloc_scope;
+    [[maybe_unused]] const auto timer = stats_.time_update_tick();
+    if (recorder_) {
+        recorder_->append(price, epoch_us);
+    }
+    const std::optional<PendingReturn> ret = accept_tick(price, epoch_us, volume);
+    if (!ret) {
         return false;
     }
-    if (!last_price_.has_value() || !last_ts_us_.has_value()) {
-        last_price_ = price;
-        last_ts_us_ = epoch_us;
+    if (queue_) {
+        if (!queue_->try_push(*ret)) {
+            stats_.rejected(TickRejection::queue_full);
+            return false;
+        }
+        stats_.accepted();
+        if (shared_) {
+            publish_shared();
+        }
+        return true;
+    }
+    stats_.accepted();
+    append_return(ret->r, ret->dt_us);
+    if (shared_) {
+        publish_shared();
+    }
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// Batch ingestion
+// -----------------------------------------------------------------------------
+//
+// Same validity rules as update_tick, applied to prices[i], epoch_us[i] for
+// i < min(prices.size(), epoch_us.size()). With run_recalibration the usual
+// maybe_update_params() gates are checked after every accepted return (sync
+// mode). In async mode a full queue applies backpressure (yield and retry)
+// instead of dropping, since a backfill is not latency-critical.
+//
+// Returns the number of accepted returns.
+// -----------------------------------------------------------------------------
+
+std::size_t OnlineMertonCalibrator::update_ticks(
+    std::span<const double> prices, std::span<const std::int64_t> epoch_us, bool run_recalibration) {
+    AllocationScope alloc_scope;
+    const std::size_t n = std::min(prices.size(), epoch_us.size());
+    std::size_t accepted = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (recorder_) {
+            recorder_->append(prices[i], epoch_us[i]);
+        }
+        const std::optional<PendingReturn> ret = accept_tick(prices[i], epoch_us[i]);
+        if (!ret) {
+            continue;
+        }
+        ++accepted;
+        stats_.accepted();
+        if (queue_) {
+            while (!queue_->try_push(*ret)) {
+                std::this_thread::yield();
+            }
+            continue;
+        }
+        append_return(ret->r, ret->dt_us);
+        if (run_recalibration && recalibration_due()) {
+            recalibrate();
+        }
+    }
+    if (shared_ && accepted > 0) {
+        publish_shared();
+    }
+    return accepted;
+}
+
+// -----------------------------------------------------------------------------
+// Tick capture
+// -----------------------------------------------------------------------------
+//
+// Raw (price, epoch_us) inputs are recorded before validation, so a replay
+// of the file reproduces the ingestion exactly. The writer buffers a block
+// in memory; update_tick pays one I/O write per block_ticks ticks.
+// -----------------------------------------------------------------------------
+
+bool OnlineMertonCalibrator::start_recording(const std::string& path, double price_scale) {
+    auto writer = std::make_unique<CompactTickWriter>();
+    if (!writer->open(path, price_scale)) {
         return false;
     }
+    if (recorder_) {
+        recorder_->close();
+    }
+    recorder_ = std::move(writer);
+    return true;
+}
 
-    const std::int64_t dt_us = epoch_us - *last_ts_us_;
-    if (dt_us <= 0) {
+bool OnlineMertonCalibrator::stop_recording() {
+    if (!recorder_) {
+        return false;
+    }
+    const bool ok = recorder_->close();
+    recorder_.reset();
+    return ok;
+}
+
+// -----------------------------------------------------------------------------
+// Cross-process publication
+// -----------------------------------------------------------------------------
+//
+// The shared record is written on the ingestion thread only (the segment's
+// seqlock needs a single writer): the published params snapshot, its dt
+// estimate, and the fair value at the last accepted price. One seqlock
+// store per accepted tick; readers in other processes poll it.
+// -----------------------------------------------------------------------------
+
+bool OnlineMertonCalibrator::start_publishing(const std::string& name, double q_annual, double horizon_years,
+                                              double r) {
+    auto publisher = std::make_unique<SharedParamsPublisher>();
+    if (!publisher->open(name)) {
+        return false;
+    }
+    shared_ = std::move(publisher);
+    shared_record_ = SharedParams{};
+    shared_record_.q_annual = q_annual;
+    shared_record_.horizon_years = horizon_years;
+    shared_record_.r = r;
+    publish_shared();
+    return true;
+}
+
+void OnlineMertonCalibrator::stop_publishing() {
+    shared_.reset();
+}
+
+void OnlineMertonCalibrator::publish_shared() {
+    std::uint64_t version = 0;
+    const PublishedParams pub = published_.load(version);
+    SharedParams& rec = shared_record_;
+    rec.params = pub.params;
+    rec.params_version = version;
+    rec.dt_years = pub.dt_years;
+    rec.s0 = last_price_.value_or(0.0);
+    rec.epoch_us = last_ts_us_.value_or(0);
+    rec.fair_value = rec.s0 * std::exp((rec.r - rec.q_annual - pub.jump_drift) * rec.horizon_years);
+    shared_->store(rec);
+}
+
+// -----------------------------------------------------------------------------
+// Tick validation
+// -----------------------------------------------------------------------------
+//
+// Advances last_price_ / last_ts_us_ and returns (r, dt_us) when the tick
+// the prefilter hands on forms a valid return against the previous one (see
+// update_tick). Invalid prices are rejected before they reach the filter.
+// -----------------------------------------------------------------------------
+
+std::optional<OnlineMertonCalibrator::PendingReturn> OnlineMertonCalibrator::accept_tick(
+    double price, std::int64_t epoch_us, double volume) {
+    stats_.tick();
+    if (!(price > 0.0)) {
+        stats_.rejected(TickRejection::price);
+        return std::nullopt;
+    }
+    if (filter_.active()) {
+        const std::optional<FilteredTick> sampled = filter_.push(price, epoch_us, volume);
+        if (!sampled) {
+            return std::nullopt;
+        }
+        price = sampled->price;
+        epoch_us = sampled->epoch_us;
+    }
+    if (!last_price_.has_value() || !last_ts_us_.has_value()) {
         last_price_ = price;
         last_ts_us_ = epoch_us;
-        return false;
+        stats_.rejected(TickRejection::first_tick);
+        return std::nullopt;
     }
 
+    const std::int64_t dt_us = epoch_us - *last_ts_us_;
     const double r = std::log(price / *last_price_);
+    last_price_ = price;
+    last_ts_us_ = epoch_us;
+    if (dt_us <= 0) {
+        stats_.rejected(TickRejection::dt);
+        return std::nullopt;
+    }
     if (!std::isfinite(r)) {
-        last_price_ = price;
-        last_ts_us_ = epoch_us;
-        return false;
+        stats_.rejected(TickRejection::non_finite);
+        return std::nullopt;
     }
+    if (config_.window_size == 0) {
+        return std::nullopt;
+    }
+    return PendingReturn{r, dt_us};
+}
 
-    returns_.push_back(r);
-    dt_us_.push_back(dt_us);
-    if (returns_.size() > config_.window_size) {
-        returns_.pop_front();
-        dt_us_.pop_front();
+// -----------------------------------------------------------------------------
+// Window maintenance
+// -----------------------------------------------------------------------------
+//
+//   - Evicts the oldest sample if the window is full (FIFO)
+//   - Appends (r, dt_us) to the preallocated ring buffer (no allocation)
+//   - Keeps histogram_ (or dt_histogram_) and dt_median_ in sync (remove
+//     evicted, add new)
+//   - Increments returns_since_last_update_ for gating recalibration
+//   - online_em: E-step of the new return under params_ at its own dt
+//
+// Runs on the caller thread in sync mode and on the worker in async mode.
+// -----------------------------------------------------------------------------
+
+void OnlineMertonCalibrator::append_return(double r, std::int64_t dt_us, bool learn) {
+    if (window_.full()) {
+        if (dt_histogram_) {
+            dt_histogram_->remove(window_.front_return(), window_.front_dt_us());
+        } else {
+            histogram_.remove(window_.front_return());
+        }
+        dt_median_.remove(window_.front_dt_us());
+        window_.pop_front();
+    }
+    window_.push_back(r, dt_us);
+    if (dt_histogram_) {
+        dt_histogram_->add(r, dt_us);
+    } else {
+        histogram_.add(r);
+    }
+    dt_median_.add(dt_us);
+    if (config_.optimizer == OptimizerMode::online_em) {
+        const double dt = static_cast<double>(dt_us) / 1e6 / kSecsPerYear;
+        em_.observe(mixture_terms(params_, dt), params_, r, dt);
+    }
+    if (config_.optimizer == OptimizerMode::online_sgd && learn &&
+        window_.size() >= config_.min_points_for_update) {
+        sgd_step(r, static_cast<double>(dt_us) / 1e6 / kSecsPerYear);
     }
 
     ++returns_since_last_update_;
-    last_price_ = price;
-    last_ts_us_ = epoch_us;
-    return true;
+    sample_count_.store(window_.size(), std::memory_order_relaxed);
+}
+
+// -----------------------------------------------------------------------------
+// Streaming gradient step (online_sgd)
+// -----------------------------------------------------------------------------
+//
+// Each return, at its own dt, costs one make_mixture_terms and a one-return
+// fused NLL + gradient; the SGD engine turns that into a step, clamp_params
+// projects it back onto the box and a moved point is published at once. The
+// window is still maintained (warm-up gate, snapshots, kernel_width), but
+// never rescanned: maybe_update_params() reduces to polling the version.
+// -----------------------------------------------------------------------------
+
+void OnlineMertonCalibrator::sgd_step(double r, double dt_years) {
+    stats_.gradient_evaluation();
+    MertonParams grad;
+    mixture_nll_gradient(mixture_terms(params_, dt_years), params_, dt_years, std::span<const double>(&r, 1), {},
+                         grad);
+    const MertonParams next = clamp_params(sgd_.step(params_, grad));
+    if (next.sigma != params_.sigma || next.lambda != params_.lambda || next.mu_j != params_.mu_j ||
+        next.delta_j != params_.delta_j) {
+        params_ = next;
+        publish();
+    }
 }
 
 // -----------------------------------------------------------------------------
@@ -139,28 +448,48 @@ bool OnlineMertonCalibrator::update_tick(double price, std::int64_t epoch_us) {
 // -----------------------------------------------------------------------------
 //
 // Runs only when:
-//   - returns_.size() >= min_points_for_update
+//   - window_.size() >= min_points_for_update
 //   - returns_since_last_update_ >= update_every_n_returns
 //
-// Uses dt = median of dt_us_ (in years) as representative time step.
+// Uses dt = median of window dt_us (in years) as representative time step.
 // Coordinate-search: for each param, try +/- step; keep if NLL improves by
 // improvement_tol. If no improvement in a round, halve all steps. Repeats
-// coordinate_steps rounds.
+// coordinate_steps rounds. A round is either greedy (gauss_seidel: accept
+// as soon as a candidate improves) or jacobi (evaluate all 8 candidates
+// around the same point in parallel, then move to the best).
 //
 // Step sizes: 8% of sigma, 10% of lambda, 25% of |mu_j|, 20% of delta_j,
 // with floors to avoid degenerate steps.
 //
-// Returns true iff any parameter actually changed.
+// Returns true iff any parameter actually changed; changes are published to
+// published_. In async mode the worker runs this and maybe_update_params()
+// only polls the published version.
 // -----------------------------------------------------------------------------
 
 bool OnlineMertonCalibrator::maybe_update_params() {
-    if (returns_.size() < config_.min_points_for_update) {
-        return false;
+    AllocationScope alloc_scope;
+    bool changed = false;
+    if (queue_ || config_.optimizer == OptimizerMode::online_sgd) {
+        const std::uint64_t version = published_.version();
+        changed = version != last_polled_version_;
+        last_polled_version_ = version;
+    } else if (recalibration_due()) {
+        changed = recalibrate();
     }
-    if (returns_since_last_update_ < config_.update_every_n_returns) {
-        return false;
+    if (changed && shared_) {
+        publish_shared();
     }
+    return changed;
+}
 
+bool OnlineMertonCalibrator::recalibration_due() const {
+    return config_.optimizer != OptimizerMode::online_sgd && window_.size() >= config_.min_points_for_update &&
+           returns_since_last_update_ >= config_.update_every_n_returns;
+}
+
+bool OnlineMertonCalibrator::recalibrate() {
+    [[maybe_unused]] const auto timer = stats_.time_recalibration();
+    const std::size_t added = returns_since_last_update_;
     returns_since_last_update_ = 0;
     const double dt = estimate_dt_years();
     if (!(dt > 0.0)) {
@@ -168,50 +497,44 @@ bool OnlineMertonCalibrator::maybe_update_params() {
     }
 
     MertonParams best = params_;
-    double best_nll = neg_log_likelihood(best, dt);
-
-    // Adaptive step sizes: percentage of current param with floors
-    MertonParams step{
-        std::max(0.02, best.sigma * 0.08),
-        std::max(0.10, best.lambda * 0.10),
-        std::max(0.002, std::abs(best.mu_j) * 0.25),
-        std::max(0.002, best.delta_j * 0.20),
-    };
-
-    for (std::size_t iter = 0; iter < config_.coordinate_steps; ++iter) {
-        bool improved = false;
-
-        // Try candidate; accept if NLL improves by at least improvement_tol
-        auto try_param = [&](const MertonParams& candidate) {
-            const MertonParams c = clamp_params(candidate);
-            const double nll = neg_log_likelihood(c, dt);
-            if (std::isfinite(nll) && (best_nll - nll) > config_.improvement_tol) {
-                best = c;
-                best_nll = nll;
-                improved = true;
+    double start_nll = 0.0;
+    double best_nll = 0.0;
+    if (config_.optimizer == OptimizerMode::online_em && em_.online_seeded()) {
+        // No pass over the window: the reported NLL is the decayed per-tick
+        // score scaled to the window size.
+        best = em_.online_params(params_);
+        start_nll = em_.online_nll_per_return() * static_cast<double>(window_.size());
+        best_nll = start_nll;
+    } else {
+        // The trigger needs NLL(params_) before the optimizer runs; em gets
+        // it from its first E-step otherwise, so it pays one extra pass here.
+        const bool global = config_.global_search_starts > 0;
+        if (global) {
+            best_nll = neg_log_likelihood(best, dt);
+            start_nll = best_nll;
+            if (nll_jumped(start_nll, added)) {
+                global_search(best, best_nll, dt);
             }
-        };
-
-        MertonParams c = best;
-        c.sigma += step.sigma; try_param(c);
-        c = best; c.sigma -= step.sigma; try_param(c);
-
-        c = best; c.lambda += step.lambda; try_param(c);
-        c = best; c.lambda -= step.lambda; try_param(c);
-
-        c = best; c.mu_j += step.mu_j; try_param(c);
-        c = best; c.mu_j -= step.mu_j; try_param(c);
-
-        c = best; c.delta_j += step.delta_j; try_param(c);
-        c = best; c.delta_j -= step.delta_j; try_param(c);
-
-        // Shrink steps if no improvement this round (refinement)
-        if (!improved) {
-            step.sigma *= 0.5;
-            step.lambda *= 0.5;
-            step.mu_j *= 0.5;
-            step.delta_j *= 0.5;
         }
+        if (config_.optimizer == OptimizerMode::em || config_.optimizer == OptimizerMode::online_em) {
+            double em_start_nll = 0.0;
+            em_search(best, em_start_nll, best_nll, dt);
+            if (!global) {
+                start_nll = em_start_nll;
+            }
+        } else {
+            if (!global) {
+                best_nll = neg_log_likelihood(best, dt);
+                start_nll = best_nll;
+            }
+            if (config_.optimizer == OptimizerMode::lbfgsb) {
+                lbfgs_search(best, best_nll, dt);
+            } else {
+                coordinate_search(best, best_nll, dt);
+            }
+        }
+        last_fit_nll_ = best_nll;
+        last_fit_returns_ = window_.size();
     }
 
     // Report change if any param moved beyond floating-point noise
@@ -221,114 +544,523 @@ bool OnlineMertonCalibrator::maybe_update_params() {
         (std::abs(best.mu_j - params_.mu_j) > 1e-12) ||
         (std::abs(best.delta_j - params_.delta_j) > 1e-12);
 
-    params_ = best;
+    if (changed) {
+        params_ = best;
+        publish();
+    }
+    stats_.recalibrated(start_nll, best_nll, changed);
     return changed;
 }
 
+/// Stores params_ (and its lambda*k) for readers; bumps params_version().
+void OnlineMertonCalibrator::publish() {
+    published_.store(PublishedParams{params_, params_.lambda * jump_compensator(params_.mu_j, params_.delta_j),
+                                     estimate_dt_years()});
+}
+
 // -----------------------------------------------------------------------------
-// Fair value (analytic)
+// Coordinate search
+// -----------------------------------------------------------------------------
+
+void OnlineMertonCalibrator::coordinate_search(MertonParams& best, double& best_nll, double dt) {
+    MertonParams step = initial_steps(best);
+
+    for (std::size_t iter = 0; iter < config_.coordinate_steps; ++iter) {
+        const bool improved = config_.search_mode == SearchMode::jacobi
+            ? jacobi_round(best, best_nll, step, dt)
+            : gauss_seidel_round(best, best_nll, step, dt);
+
+        // Shrink steps if no improvement this round (refinement)
+        if (!improved) {
+            halve_steps(step);
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Search rounds
 // -----------------------------------------------------------------------------
 //
-// E[S_T] = S0 * exp((r - q - lambda*k)*T)
-// with k = jump_compensator(mu_j, delta_j). No QuantLib in hot path.
+// gauss_seidel_round: candidates are built from the running best, so an
+// accepted sigma move is already in effect for the lambda candidates, etc.
+//
+// jacobi_round: the 8 candidates are independent, so they are evaluated on
+// search_pool_ (plus the caller) and the largest improvement wins. Ties go to
+// the earlier candidate, matching the gauss_seidel visiting order.
+//
+// Both return true iff best moved.
 // -----------------------------------------------------------------------------
 
-double OnlineMertonCalibrator::fair_value(double s0, double q_annual, double t_years, double r) const {
-    const double k = jump_compensator(params_.mu_j, params_.delta_j);
-    const double drift = r - q_annual - params_.lambda * k;
-    return s0 * std::exp(drift * t_years);
+bool OnlineMertonCalibrator::gauss_seidel_round(
+    MertonParams& best, double& best_nll, const MertonParams& step, double dt) const {
+    bool improved = false;
+
+    // Try candidate; accept if NLL improves by at least improvement_tol
+    auto try_param = [&](const MertonParams& candidate) {
+        const MertonParams c = clamp_params(candidate);
+        const double nll = neg_log_likelihood(c, dt);
+        if (std::isfinite(nll) && (best_nll - nll) > config_.improvement_tol) {
+            best = c;
+            best_nll = nll;
+            improved = true;
+        }
+    };
+
+    MertonParams c = best;
+    c.sigma += step.sigma; try_param(c);
+    c = best; c.sigma -= step.sigma; try_param(c);
+
+    c = best; c.lambda += step.lambda; try_param(c);
+    c = best; c.lambda -= step.lambda; try_param(c);
+
+    c = best; c.mu_j += step.mu_j; try_param(c);
+    c = best; c.mu_j -= step.mu_j; try_param(c);
+
+    c = best; c.delta_j += step.delta_j; try_param(c);
+    c = best; c.delta_j -= step.delta_j; try_param(c);
+
+    return improved;
+}
+
+bool OnlineMertonCalibrator::jacobi_round(
+    MertonParams& best, double& best_nll, const MertonParams& step, double dt) {
+    std::array<MertonParams, 8> candidates;
+    candidates.fill(best);
+    candidates[0].sigma += step.sigma;
+    candidates[1].sigma -= step.sigma;
+    candidates[2].lambda += step.lambda;
+    candidates[3].lambda -= step.lambda;
+    candidates[4].mu_j += step.mu_j;
+    candidates[5].mu_j -= step.mu_j;
+    candidates[6].delta_j += step.delta_j;
+    candidates[7].delta_j -= step.delta_j;
+
+    std::array<double, 8> nll;
+    const auto evaluate = [&](std::size_t i) {
+        candidates[i] = clamp_params(candidates[i]);
+        nll[i] = neg_log_likelihood(candidates[i], dt);
+    };
+    if (search_pool_) {
+        search_pool_->parallel_for(candidates.size(), evaluate);
+    } else {
+        for (std::size_t i = 0; i < candidates.size(); ++i) {
+            evaluate(i);
+        }
+    }
+
+    std::size_t winner = candidates.size();
+    double winner_nll = best_nll - config_.improvement_tol;
+    for (std::size_t i = 0; i < candidates.size(); ++i) {
+        if (std::isfinite(nll[i]) && nll[i] < winner_nll) {
+            winner = i;
+            winner_nll = nll[i];
+        }
+    }
+    if (winner == candidates.size()) {
+        return false;
+    }
+    best = candidates[winner];
+    best_nll = winner_nll;
+    return true;
 }
 
 // -----------------------------------------------------------------------------
-// Fair value (QuantLib-based helper)
+// Global search (multi-start)
 // -----------------------------------------------------------------------------
 //
-// Uses flat r/q curves and F = S0 * Dq(T)/Dr(T), then applies Merton jump
-// adjustment: F * exp(-lambda*k*T). Used for validation or when curve objects
-// are needed; not used in the hot path.
+// The local optimizers only ever start from params_, so after a regime change
+// they can settle in the basin they were in. The trigger compares NLL(params_)
+// on the current window with the last fit, extrapolated to the current
+// window size at the fit's average per return:
+//   jump = (nll - last_fit_nll * n / n_fit) / added
+// i.e. the excess NLL per return added since then (once the window is full,
+// simply the rise of the total over the added returns). Under a stationary
+// tape it stays around 0 +- 1/sqrt(added); a tripled vol costs ~3 nats per
+// new return.
+//
+// When it fires, global_search_starts points of a (fresh, unscrambled) 4-d
+// Sobol sequence mapped onto the clamp box are spread over search_pool_ by
+// one parallel_for. Each start runs on its own thread: a full fused NLL pass
+// and then coordinate_steps gauss_seidel rounds from it, since a raw point of
+// a coarse 4-d design almost never beats an incumbent that has been tracking
+// the window. The best polished start replaces best only if it wins by
+// improvement_tol; the configured optimizer then refines it in the same
+// recalibration.
 // -----------------------------------------------------------------------------
 
-double OnlineMertonCalibrator::fair_value_quantlib(double s0, double q_annual, double t_years, double r) const {
-    if (!(s0 > 0.0)) {
-        return s0;
+bool OnlineMertonCalibrator::nll_jumped(double nll, std::size_t added) const {
+    if (last_fit_returns_ == 0 || added == 0 || !std::isfinite(nll) || !std::isfinite(last_fit_nll_)) {
+        return false;
     }
+    const double expected =
+        last_fit_nll_ * static_cast<double>(window_.size()) / static_cast<double>(last_fit_returns_);
+    return (nll - expected) / static_cast<double>(added) > config_.global_search_trigger;
+}
 
-    using namespace QuantLib;
-    const Date today = Date::todaysDate();
-    Settings::instance().evaluationDate() = today;
-    const DayCounter dc = Actual365Fixed();
+void OnlineMertonCalibrator::global_search(MertonParams& best, double& best_nll, double dt) {
+    stats_.global_search();
+    SobolSequence<4> sobol;
+    sobol.next();  // skip the origin (all four params on their lower bounds)
+    global_candidates_[0] = best;
+    for (std::size_t i = 1; i < global_candidates_.size(); ++i) {
+        const auto u = sobol.next();
+        global_candidates_[i] = MertonParams{
+            kParamLower.sigma + u[0] * (kParamUpper.sigma - kParamLower.sigma),
+            kParamLower.lambda + u[1] * (kParamUpper.lambda - kParamLower.lambda),
+            kParamLower.mu_j + u[2] * (kParamUpper.mu_j - kParamLower.mu_j),
+            kParamLower.delta_j + u[3] * (kParamUpper.delta_j - kParamLower.delta_j),
+        };
+    }
 
-    const Integer days = std::max<Integer>(1, static_cast<Integer>(std::llround(std::max(t_years, 1e-8) * 365.25)));
-    const Date maturity = today + days;
-    const Time t = dc.yearFraction(today, maturity);
-    if (!(t > 0.0)) {
-        return s0;
+    // The incumbent's NLL is already known.
+    global_nll_[0] = std::isfinite(best_nll) ? best_nll : std::numeric_limits<double>::infinity();
+    const auto evaluate = [&](std::size_t i) {
+        MertonParams& c = global_candidates_[i + 1];
+        double nll = neg_log_likelihood(c, dt);
+        if (std::isfinite(nll)) {
+            MertonParams step = initial_steps(c);
+            for (std::size_t iter = 0; iter < config_.coordinate_steps; ++iter) {
+                if (!gauss_seidel_round(c, nll, step, dt)) {
+                    halve_steps(step);
+                }
+            }
+        }
+        global_nll_[i + 1] = nll;
+    };
+    const std::size_t starts = global_candidates_.size() - 1;
+    if (search_pool_) {
+        search_pool_->parallel_for(starts, evaluate);
+    } else {
+        for (std::size_t i = 0; i < starts; ++i) {
+            evaluate(i);
+        }
     }
 
-    const auto r_curve = Handle<YieldTermStructure>(
-        ext::make_shared<FlatForward>(today, r, dc));
-    const auto q_curve = Handle<YieldTermStructure>(
-        ext::make_shared<FlatForward>(today, q_annual, dc));
+    std::size_t winner = 0;
+    for (std::size_t i = 1; i < global_candidates_.size(); ++i) {
+        if (std::isfinite(global_nll_[i]) && global_nll_[i] < global_nll_[winner]) {
+            winner = i;
+        }
+    }
+    if (winner != 0 && (global_nll_[0] - global_nll_[winner]) > config_.improvement_tol) {
+        best = global_candidates_[winner];
+        best_nll = global_nll_[winner];
+    }
+}
 
-    // Forward from discount factors: F = S0 * Dq(T) / Dr(T) (no-jump forward)
-    const double forward = s0 * (q_curve->discount(maturity) / r_curve->discount(maturity));
+// -----------------------------------------------------------------------------
+// L-BFGS search
+// -----------------------------------------------------------------------------
+//
+// Minimizes the NLL over the clamp_params box with BoxLbfgs. Each evaluation
+// is one fused NLL + analytic gradient pass over the histogram. The search is
+// run in box-normalized coordinates u = (p - lower) / (upper - lower) so one
+// step length suits all four parameters. best is only replaced when the
+// result beats best_nll by improvement_tol.
+// -----------------------------------------------------------------------------
 
-    // Merton jump compensator adjustment: forward * exp(-lambda*k*T)
-    const double k = jump_compensator(params_.mu_j, params_.delta_j);
-    return forward * std::exp(-params_.lambda * k * t);
+void OnlineMertonCalibrator::lbfgs_search(MertonParams& best, double& best_nll, double dt) const {
+    using Vec = BoxLbfgs<4>::Vec;
+    const Vec lo{kParamLower.sigma, kParamLower.lambda, kParamLower.mu_j, kParamLower.delta_j};
+    const Vec hi{kParamUpper.sigma, kParamUpper.lambda, kParamUpper.mu_j, kParamUpper.delta_j};
+
+    auto to_params = [&](const Vec& u) {
+        return MertonParams{
+            lo[0] + u[0] * (hi[0] - lo[0]),
+            lo[1] + u[1] * (hi[1] - lo[1]),
+            lo[2] + u[2] * (hi[2] - lo[2]),
+            lo[3] + u[3] * (hi[3] - lo[3]),
+        };
+    };
+
+    const MertonParams start = clamp_params(best);
+    const Vec u0{
+        (start.sigma - lo[0]) / (hi[0] - lo[0]),
+        (start.lambda - lo[1]) / (hi[1] - lo[1]),
+        (start.mu_j - lo[2]) / (hi[2] - lo[2]),
+        (start.delta_j - lo[3]) / (hi[3] - lo[3]),
+    };
+
+    BoxLbfgsOptions options;
+    options.max_iterations = config_.lbfgs_iterations;
+    options.f_tol = config_.improvement_tol;
+    BoxLbfgs<4> solver(Vec{0.0, 0.0, 0.0, 0.0}, Vec{1.0, 1.0, 1.0, 1.0}, options);
+
+    const auto result = solver.minimize(u0, [&](const Vec& u, Vec& g) {
+        MertonParams grad;
+        const double nll = nll_gradient(to_params(u), dt, grad);
+        g = Vec{
+            grad.sigma * (hi[0] - lo[0]),
+            grad.lambda * (hi[1] - lo[1]),
+            grad.mu_j * (hi[2] - lo[2]),
+            grad.delta_j * (hi[3] - lo[3]),
+        };
+        return nll;
+    });
+
+    if (std::isfinite(result.f) && (best_nll - result.f) > config_.improvement_tol) {
+        best = clamp_params(to_params(result.x));
+        best_nll = result.f;
+    }
 }
 
 // -----------------------------------------------------------------------------
-// Merton jump-diffusion PDF (truncated Poisson-Gaussian mixture)
+// EM search
 // -----------------------------------------------------------------------------
 //
-// f(x) = sum_{n=0}^{n_max} P(N=n) * phi((x - mu_n) / sigma_n) / sigma_n
-// where:
-//   drift = (-lambda*k - 0.5*sigma^2)*dt
-//   mu_n = drift + n*mu_j
-//   var_n = sigma^2*dt + n*delta_j^2
-//   P(N=n) = exp(-lambda*dt) * (lambda*dt)^n / n!
-//
-// Returns max(pdf, 1e-300) to avoid zero in neg_log_likelihood.
+// Batch EM from best (see em_calibrator.hpp): every iteration is one fused
+// E-step pass over the histogram that also yields the NLL of the params it
+// scores, so the first pass doubles as the start NLL and no separate
+// evaluation is needed. Accepted iterations are strict NLL improvements;
+// iteration stops once one gains less than improvement_tol. online_em runs
+// this once to seed its per-tick statistics with the final E-step.
 // -----------------------------------------------------------------------------
 
-double OnlineMertonCalibrator::merton_pdf(double x, const MertonParams& p, double dt_years) const {
-    const double lambda_dt = p.lambda * dt_years;
-    const double k = jump_compensator(p.mu_j, p.delta_j);
-    const double drift = (-p.lambda * k - 0.5 * p.sigma * p.sigma) * dt_years;
+void OnlineMertonCalibrator::em_search(MertonParams& best, double& start_nll, double& best_nll, double dt) {
+    const EmResult result = em_.fit(best, [&](const MertonParams& p, EmSufficientStats& stats) {
+        return em_e_step(p, dt, stats);
+    });
+    start_nll = result.start_nll;
+    best_nll = result.nll;
+    if (!std::isfinite(result.nll)) {
+        return;
+    }
+    best = result.params;
+    if (config_.optimizer == OptimizerMode::online_em) {
+        em_.seed_online(result.stats, result.nll);
+    }
+}
+
+/// E-step over the window histogram(s); returns NLL(p). Bucketed like
+/// neg_log_likelihood under heterogeneous_dt.
+double OnlineMertonCalibrator::em_e_step(const MertonParams& p, double dt_years, EmSufficientStats& stats) const {
+    stats_.nll_evaluation();
+    if (dt_histogram_) {
+        double nll = 0.0;
+        dt_histogram_->for_each_bucket([&](double dt_us, const ReturnHistogram& h) {
+            const double dt = dt_us / 1e6 / kSecsPerYear;
+            const MixtureTerms terms = mixture_terms(p, dt);
+            nll += mixture_em_stats(terms, p, dt, h.values(), h.counts(), stats);
+        });
+        return nll;
+    }
+    const MixtureTerms terms = mixture_terms(p, dt_years);
+    return mixture_em_stats(terms, p, dt_years, histogram_.values(), histogram_.counts(), stats);
+}
 
-    double pdf = 0.0;
-    for (std::size_t n = 0; n < config_.n_max; ++n) {
-        // Conditional mean and variance given n jumps
-        const double mu_n = drift + static_cast<double>(n) * p.mu_j;
-        const double var_n = p.sigma * p.sigma * dt_years + static_cast<double>(n) * p.delta_j * p.delta_j;
-        if (var_n <= 0.0) {
+// -----------------------------------------------------------------------------
+// Background worker (async mode)
+// -----------------------------------------------------------------------------
+//
+// Drains the tick queue into the window, then recalibrates when the usual
+// gates pass. Ticks arriving during a search stay queued and are folded in
+// before the next one, so the search always sees a consistent window.
+// Idles with yield, then short sleeps, to keep the hot thread syscall-free.
+// -----------------------------------------------------------------------------
+
+void OnlineMertonCalibrator::worker_loop() {
+    unsigned idle_polls = 0;
+    while (!stop_.load(std::memory_order_acquire)) {
+        bool drained = false;
+        AllocationScope alloc_scope;
+        while (const std::optional<PendingReturn> item = queue_->try_pop()) {
+            append_return(item->r, item->dt_us);
+            drained = true;
+        }
+        if (drained) {
+            idle_polls = 0;
+            if (recalibration_due()) {
+                recalibrate();
+            }
             continue;
         }
-        const double sigma_n = std::sqrt(var_n);
-        const double z = (x - mu_n) / sigma_n;
-        pdf += poisson_weight(n, lambda_dt) * (standard_normal_pdf(z) / sigma_n);  // N(mu_n, var_n) contribution
+        if (++idle_polls < kWorkerSpinPolls) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(kWorkerIdleSleep);
+        }
     }
-    return std::max(pdf, 1e-300);
+}
+
+// -----------------------------------------------------------------------------
+// Window views
+// -----------------------------------------------------------------------------
+//
+// The window columns are mirrored rings, so each view is a plain span into
+// them. window_log_likelihood reads the window like any other reader (the
+// worker may be appending in async mode): the dt median and log densities
+// are computed from relaxed loads of one views() state and redone if the
+// window moved meanwhile.
+// -----------------------------------------------------------------------------
+
+WindowView<double> OnlineMertonCalibrator::window_returns() const {
+    const ReturnWindow::Views v = window_.views();
+    return {v.returns, window_.storage(), v.version};
+}
+
+WindowView<std::int64_t> OnlineMertonCalibrator::window_dt_us() const {
+    const ReturnWindow::Views v = window_.views();
+    return {v.dt_us, window_.storage(), v.version};
+}
+
+WindowView<double> OnlineMertonCalibrator::window_log_likelihood() {
+    AllocationScope alloc_scope;
+    const MertonParams p = params();
+    double* out = log_likelihood_->data();
+    for (;;) {
+        const ReturnWindow::Views v = window_.views();
+        const std::size_t n = v.returns.size();
+        if (n > 0) {
+            for (std::size_t i = 0; i < n; ++i) {
+                dt_scratch_[i] = load_relaxed(v.dt_us[i]);
+            }
+            const auto mid = dt_scratch_.begin() + static_cast<std::ptrdiff_t>(n / 2);
+            std::nth_element(dt_scratch_.begin(), mid, dt_scratch_.begin() + static_cast<std::ptrdiff_t>(n));
+            const MixtureTerms terms = mixture_terms(p, static_cast<double>(*mid) / 1e6 / kSecsPerYear);
+            for (std::size_t i = 0; i < n; ++i) {
+                const double x = load_relaxed(v.returns[i]);
+                out[i] = -mixture_nll(terms, std::span<const double>(&x, 1));
+            }
+        }
+        if (window_.unchanged_since(v.version)) {
+            return {std::span<const double>(out, n), log_likelihood_, v.version};
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Fair value (analytic)
+// -----------------------------------------------------------------------------
+//
+// E[S_T] = S0 * exp((r - q - lambda*k)*T)
+// with k = jump_compensator(mu_j, delta_j). lambda*k is computed once per
+// params version by publish(). No QuantLib in hot path.
+// -----------------------------------------------------------------------------
+
+std::uint64_t OnlineMertonCalibrator::params_into(MertonParams& out) const {
+    std::uint64_t version = 0;
+    out = published_.load(version).params;
+    return version;
+}
+
+MixtureKernelWidth OnlineMertonCalibrator::kernel_width(double dt_years) const {
+    return mixture_terms(params(), dt_years).width;
+}
+
+double OnlineMertonCalibrator::fair_value(double s0, double q_annual, double t_years, double r) const {
+    AllocationScope alloc_scope;
+    const double drift = r - q_annual - published_.load().jump_drift;
+    return s0 * std::exp(drift * t_years);
+}
+
+bool OnlineMertonCalibrator::fair_values(std::span<const double> s0, std::span<const double> q_annual,
+                                         std::span<const double> t_years, std::span<const double> r,
+                                         std::span<double> out) const {
+    AllocationScope alloc_scope;
+    const std::size_t n = std::max({s0.size(), q_annual.size(), t_years.size(), r.size()});
+    auto fits = [n](std::span<const double> v) { return v.size() == n || v.size() == 1; };
+    if (n == 0 || !fits(s0) || !fits(q_annual) || !fits(t_years) || !fits(r) || out.size() < n) {
+        return n == 0;
+    }
+    // Stride 0 broadcasts a length-1 input.
+    const std::size_t ds = s0.size() == n ? 1 : 0;
+    const std::size_t dq = q_annual.size() == n ? 1 : 0;
+    const std::size_t dt = t_years.size() == n ? 1 : 0;
+    const std::size_t dr = r.size() == n ? 1 : 0;
+    const double jump_drift = published_.load().jump_drift;
+    for (std::size_t i = 0; i < n; ++i) {
+        const double drift = r[i * dr] - q_annual[i * dq] - jump_drift;
+        out[i] = s0[i * ds] * std::exp(drift * t_years[i * dt]);
+    }
+    return true;
+}
+// -----------------------------------------------------------------------------
+// Fair value (QuantLib-based helper)
+// -----------------------------------------------------------------------------
+//
+// F = S0 * Dq(T)/Dr(T) from the cached curves in ql_curves_ (flat r/q
+// quotes unless relinked to term structures), then the Merton jump
+// adjustment F * exp(-lambda*k*T). A repeat call with unchanged r/q and
+// date only does the two discount lookups.
+// -----------------------------------------------------------------------------
+
+double OnlineMertonCalibrator::fair_value_quantlib(double s0, double q_annual, double t_years, double r) const {
+    AllocationScope alloc_scope;
+    if (!(s0 > 0.0)) {
+        return s0;
+    }
+    double t = 0.0;
+    const double forward = ql_curves_->forward(s0, q_annual, r, t_years, t);
+    if (!(t > 0.0)) {
+        return s0;
+    }
+    // Merton jump compensator adjustment: forward * exp(-lambda*k*T)
+    return forward * std::exp(-published_.load().jump_drift * t);
+}
+
+QuantLibCarryCurves& OnlineMertonCalibrator::quantlib_curves() const {
+    return *ql_curves_;
 }
 
 // -----------------------------------------------------------------------------
 // Negative log-likelihood
 // -----------------------------------------------------------------------------
 //
-// NLL(p) = -sum_i log f(r_i | p, dt) over rolling returns_. Invalid params
+// NLL(p) = -sum_i log f(r_i | p, dt) over the rolling window, evaluated as
+// -sum_k c_k * log f(v_k | p, dt) over the histogram of distinct values v_k
+// with multiplicities c_k. histogram_ is maintained per tick, so each
+// candidate costs O(distinct returns) rather than O(window_size). Mixture
+// constants are built once per candidate and the sum runs through the
+// batched (SIMD) kernel in merton_likelihood.cpp. Invalid params
 // (sigma <= 0, lambda < 0, delta_j <= 0) return +infinity.
+//
+// heterogeneous_dt: returns are grouped by log-spaced dt bucket and each
+// group is evaluated with the mixture constants of its bucket midpoint dt,
+// i.e. one make_mixture_terms per active bucket (tens) per candidate; the
+// dt_years argument is ignored. nll_gradient follows the same split.
 // -----------------------------------------------------------------------------
 
+MixtureTerms OnlineMertonCalibrator::mixture_terms(const MertonParams& p, double dt_years) const {
+    return make_mixture_terms(p, dt_years, config_.n_max, config_.poisson_tail_eps, config_.mixture_eval);
+}
+
 double OnlineMertonCalibrator::neg_log_likelihood(const MertonParams& p, double dt_years) const {
+    stats_.nll_evaluation();
     if (!(p.sigma > 0.0) || !(p.lambda >= 0.0) || !(p.delta_j > 0.0)) {
         return std::numeric_limits<double>::infinity();
     }
-    double nll = 0.0;
-    for (const double r : returns_) {
-        nll -= safe_log(merton_pdf(r, p, dt_years));
+    if (dt_histogram_) {
+        double nll = 0.0;
+        dt_histogram_->for_each_bucket([&](double dt_us, const ReturnHistogram& h) {
+            const double dt = dt_us / 1e6 / kSecsPerYear;
+            const MixtureTerms terms = mixture_terms(p, dt);
+            nll += mixture_nll(terms, h.values(), h.counts());
+        });
+        return nll;
+    }
+    const MixtureTerms terms = mixture_terms(p, dt_years);
+    return mixture_nll(terms, histogram_.values(), histogram_.counts());
+}
+
+double OnlineMertonCalibrator::nll_gradient(const MertonParams& p, double dt_years, MertonParams& grad) const {
+    stats_.gradient_evaluation();
+    if (dt_histogram_) {
+        double nll = 0.0;
+        grad = MertonParams{0.0, 0.0, 0.0, 0.0};
+        dt_histogram_->for_each_bucket([&](double dt_us, const ReturnHistogram& h) {
+            const double dt = dt_us / 1e6 / kSecsPerYear;
+            const MixtureTerms terms = mixture_terms(p, dt);
+            MertonParams g;
+            nll += mixture_nll_gradient(terms, p, dt, h.values(), h.counts(), g);
+            grad.sigma += g.sigma;
+            grad.lambda += g.lambda;
+            grad.mu_j += g.mu_j;
+            grad.delta_j += g.delta_j;
+        });
+        return nll;
     }
-    return nll;
+    const MixtureTerms terms = mixture_terms(p, dt_years);
+    return mixture_nll_gradient(terms, p, dt_years, histogram_.values(), histogram_.counts(), grad);
 }
 
 // -----------------------------------------------------------------------------
@@ -342,10 +1074,10 @@ double OnlineMertonCalibrator::neg_log_likelihood(const MertonParams& p, double
 
 MertonParams OnlineMertonCalibrator::clamp_params(const MertonParams& p) const {
     MertonParams out = p;
-    out.sigma = std::clamp(out.sigma, 0.05, 3.0);
-    out.lambda = std::clamp(out.lambda, 0.01, 40.0);
-    out.mu_j = std::clamp(out.mu_j, -0.5, 0.5);
-    out.delta_j = std::clamp(out.delta_j, 0.01, 1.0);
+    out.sigma = std::clamp(out.sigma, kParamLower.sigma, kParamUpper.sigma);
+    out.lambda = std::clamp(out.lambda, kParamLower.lambda, kParamUpper.lambda);
+    out.mu_j = std::clamp(out.mu_j, kParamLower.mu_j, kParamUpper.mu_j);
+    out.delta_j = std::clamp(out.delta_j, kParamLower.delta_j, kParamUpper.delta_j);
     return out;
 }
 
@@ -353,17 +1085,17 @@ MertonParams OnlineMertonCalibrator::clamp_params(const MertonParams& p) const {
 // Representative time step (years)
 // -----------------------------------------------------------------------------
 //
-// Returns median(dt_us) converted to years. Used as dt_years in merton_pdf
-// and NLL for the rolling window.
+// Returns median(dt_us) converted to years. Used as dt_years in the mixture
+// and NLL for the rolling window. The median is maintained incrementally by
+// dt_median_ (bucketed Fenwick tree), so this is O(log buckets) and does not
+// allocate.
 // -----------------------------------------------------------------------------
 
 double OnlineMertonCalibrator::estimate_dt_years() const {
-    if (dt_us_.empty()) {
+    if (window_.empty()) {
         return 0.0;
     }
-    std::vector<std::int64_t> s(dt_us_.begin(), dt_us_.end());
-    std::sort(s.begin(), s.end());
-    const std::int64_t median_us = s[s.size() / 2];
+    const std::int64_t median_us = dt_median_.median();
     return static_cast<double>(median_us) / 1e6 / kSecsPerYear;
 }
 
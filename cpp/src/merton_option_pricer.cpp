@@ -0,0 +1,267 @@
+// -----------------------------------------------------------------------------
+// merton_option_pricer.cpp
+// -----------------------------------------------------------------------------
+//
+// Merton (1976) European option series (see merton_option_pricer.hpp):
+//
+//   V = sum_n P'(n) * BS(S0, K, T, r_n, sigma_n, q)
+//   P'(n)       = exp(-lambda' T) (lambda' T)^n / n!,  lambda' = lambda (1 + k)
+//   r_n         = r - lambda k + n log(1 + k) / T
+//   sigma_n^2   = sigma^2 + n delta_j^2 / T
+//
+// with k = jump_compensator(mu_j, delta_j). Everything except the strike
+// (and s0) is folded into per-term constants by rebuild(), once per params
+// version and expiry grid, so each (strike, expiry) costs one log plus two
+// erfc per kept term.
+//
+// P'(n) exp(-r_n T) equals P(n) exp(-r T) with P the Poisson(lambda T)
+// weights, so the call leg of term n is bounded by S0 exp(-q T) P'(n) and
+// the put leg by K exp(-r T) P(n). Both weights are evaluated in log space
+// (lgamma), so they neither underflow nor overflow for large lambda' T. The
+// kept terms are one contiguous range of n grown outwards from the Poisson
+// mode, one term per step, until the mass outside it is below tail_eps / 2
+// for both P' and P, or max_terms terms are kept.
+// -----------------------------------------------------------------------------
+
+#include "merton_option_pricer.hpp"
+
+#include "allocation_counter.hpp"
+#include "merton_likelihood.hpp"
+#include "merton_online_calibrator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace merton {
+
+namespace {
+
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+constexpr double kInvSqrt2 = 0.70710678118654752440;
+
+double normal_cdf(double x) {
+    return 0.5 * std::erfc(-x * kInvSqrt2);
+}
+
+/// log P(N = n) for N ~ Poisson(mean); -inf where the pmf is 0.
+double poisson_log_pmf(double n, double mean) {
+    if (mean == 0.0) {
+        return n == 0.0 ? 0.0 : -std::numeric_limits<double>::infinity();
+    }
+    return -mean + n * std::log(mean) - std::lgamma(n + 1.0);
+}
+
+}  // namespace
+
+MertonOptionPricer::MertonOptionPricer(OptionPricerConfig config)
+    : config_(config), params_{}, version_(0), has_params_(false) {
+    config_.max_terms = std::max<std::size_t>(config_.max_terms, 1);
+}
+
+bool MertonOptionPricer::set_expiries(std::span<const double> t_years, std::span<const double> q_annual,
+                                      std::span<const double> r) {
+    const std::size_t n = t_years.size();
+    auto fits = [n](std::span<const double> v) { return v.size() == n || v.size() == 1; };
+    if (n > 0 && (!fits(q_annual) || !fits(r))) {
+        return false;
+    }
+    const std::size_t dq = q_annual.size() == n ? 1 : 0;
+    const std::size_t dr = r.size() == n ? 1 : 0;
+    expiries_.resize(n);
+    for (std::size_t e = 0; e < n; ++e) {
+        expiries_[e] = Expiry{t_years[e], q_annual[e * dq], r[e * dr], 0};
+    }
+    terms_.resize(n * config_.max_terms);
+    rebuild();
+    return true;
+}
+
+bool MertonOptionPricer::update_params(const MertonParams& params, std::uint64_t version) {
+    AllocationScope alloc_scope;
+    if (has_params_ && version == version_) {
+        return false;
+    }
+    params_ = params;
+    version_ = version;
+    has_params_ = true;
+    rebuild();
+    return true;
+}
+
+bool MertonOptionPricer::update_from(const OnlineMertonCalibrator& calibrator) {
+    MertonParams params;
+    const std::uint64_t version = calibrator.params_into(params);
+    return update_params(params, version);
+}
+
+// -----------------------------------------------------------------------------
+// Series constants
+// -----------------------------------------------------------------------------
+
+void MertonOptionPricer::rebuild() {
+    if (!has_params_) {
+        return;
+    }
+    const double k = jump_compensator(params_.mu_j, params_.delta_j);
+    const double log_growth = params_.mu_j + 0.5 * params_.delta_j * params_.delta_j;  // log(1 + k)
+    const double var_jump = params_.delta_j * params_.delta_j;
+    const double half_eps = 0.5 * config_.tail_eps;
+
+    for (std::size_t e = 0; e < expiries_.size(); ++e) {
+        Expiry& ex = expiries_[e];
+        Term* out = terms_.data() + e * config_.max_terms;
+        const double t = ex.t_years;
+        ex.terms = 0;
+        const double m = params_.lambda * (1.0 + k) * t;  // mean of P'
+        const double ms = params_.lambda * t;             // mean of P
+        if (!(t > 0.0) || !std::isfinite(t) || !std::isfinite(m) || !std::isfinite(ms)) {
+            continue;
+        }
+        const double carry = std::exp(-ex.q_annual * t);
+        const double var_diff = params_.sigma * params_.sigma * t;
+        const double rt0 = (ex.r - params_.lambda * k) * t;  // r_0 T
+        const double discount = std::exp(-ex.r * t);
+        auto weight = [m](double n) { return std::exp(poisson_log_pmf(n, m)); };
+        auto strike_weight = [ms](double n) { return std::exp(poisson_log_pmf(n, ms)); };
+        std::size_t kept = 0;
+        auto keep = [&](double n, double w, double sw) {
+            const double sd = std::sqrt(var_diff + n * var_jump);
+            out[kept++] = Term{w * carry, sw * discount, rt0 + n * log_growth - ex.q_annual * t, sd, 1.0 / sd};
+        };
+
+        // Grow [lo, hi] from whichever mode carries more weight, adding the
+        // heavier neighbour each step (terms are summed, so they are stored
+        // in the order they are added). Every step keeps a term, so n stays
+        // within max_terms of the start.
+        const double mode = std::floor(m);
+        const double strike_mode = std::floor(ms);
+        double lo = weight(mode) + strike_weight(mode) >= weight(strike_mode) + strike_weight(strike_mode)
+                        ? mode
+                        : strike_mode;
+        double hi = lo;
+        double lo_w = weight(lo);
+        double lo_s = strike_weight(lo);
+        double hi_w = lo_w;
+        double hi_s = lo_s;
+        double mass = lo_w;         // sum of P'(n), n in [lo, hi]
+        double strike_mass = lo_s;  // sum of P(n), n in [lo, hi]
+        keep(lo, lo_w, lo_s);
+        // Neighbour weights by the recurrence P(n + 1) = P(n) * mean / (n + 1),
+        // or from lgamma while the edge weight is subnormal or 0 (the recurrence
+        // would stay stuck at 0 when walking towards the other mode).
+        auto step = [](double w, double factor, auto&& exact) {
+            return w >= std::numeric_limits<double>::min() ? w * factor : exact();
+        };
+        auto below = [&](double& w, double& sw) {
+            w = step(lo_w, lo / m, [&] { return weight(lo - 1.0); });
+            sw = step(lo_s, lo / ms, [&] { return strike_weight(lo - 1.0); });
+        };
+        auto above = [&](double& w, double& sw) {
+            w = step(hi_w, m / (hi + 1.0), [&] { return weight(hi + 1.0); });
+            sw = step(hi_s, ms / (hi + 1.0), [&] { return strike_weight(hi + 1.0); });
+        };
+        double below_w = 0.0, below_s = 0.0, above_w = 0.0, above_s = 0.0;
+        if (lo > 0.0) {
+            below(below_w, below_s);
+        }
+        above(above_w, above_s);
+        while (kept < config_.max_terms && (1.0 - mass >= half_eps || 1.0 - strike_mass >= half_eps)) {
+            if (lo > 0.0 && below_w + below_s > above_w + above_s) {
+                --lo;
+                lo_w = below_w;
+                lo_s = below_s;
+                keep(lo, lo_w, lo_s);
+                mass += lo_w;
+                strike_mass += lo_s;
+                below_w = below_s = 0.0;
+                if (lo > 0.0) {
+                    below(below_w, below_s);
+                }
+            } else {
+                ++hi;
+                hi_w = above_w;
+                hi_s = above_s;
+                keep(hi, hi_w, hi_s);
+                mass += hi_w;
+                strike_mass += hi_s;
+                above(above_w, above_s);
+            }
+        }
+        ex.terms = kept;
+    }
+}
+
+std::size_t MertonOptionPricer::series_terms(std::size_t expiry) const {
+    return expiry < expiries_.size() ? expiries_[expiry].terms : 0;
+}
+
+// -----------------------------------------------------------------------------
+// Pricing
+// -----------------------------------------------------------------------------
+
+double MertonOptionPricer::price_one(double s0, double strike, double log_moneyness, std::size_t expiry,
+                                     OptionRight right, double& delta) const {
+    const Expiry& ex = expiries_[expiry];
+    if (!(s0 > 0.0) || !(strike > 0.0)) {
+        delta = kNaN;
+        return kNaN;
+    }
+    const bool call = right == OptionRight::call;
+    if (ex.terms == 0) {
+        if (!(ex.t_years <= 0.0)) {
+            delta = kNaN;
+            return kNaN;  // non-finite expiry or series
+        }
+        const double intrinsic = call ? s0 - strike : strike - s0;
+        delta = intrinsic > 0.0 ? (call ? 1.0 : -1.0) : 0.0;
+        return std::max(intrinsic, 0.0);
+    }
+    const Term* term = terms_.data() + expiry * config_.max_terms;
+    const double sign = call ? 1.0 : -1.0;
+    double value = 0.0;
+    double dv = 0.0;
+    for (std::size_t n = 0; n < ex.terms; ++n) {
+        const Term& t = term[n];
+        const double d1 = (log_moneyness + t.drift) * t.inv_sd + 0.5 * t.sd;
+        const double n1 = normal_cdf(sign * d1);
+        const double n2 = normal_cdf(sign * (d1 - t.sd));
+        value += sign * (s0 * t.spot_coef * n1 - strike * t.strike_coef * n2);
+        dv += sign * t.spot_coef * n1;
+    }
+    delta = dv;
+    // Round-off can leave a deep out-of-the-money value a few ulp below 0.
+    return std::max(value, 0.0);
+}
+
+double MertonOptionPricer::price(double s0, double strike, std::size_t expiry, OptionRight right) const {
+    AllocationScope alloc_scope;
+    if (!has_params_ || expiry >= expiries_.size()) {
+        return kNaN;
+    }
+    double delta = 0.0;
+    return price_one(s0, strike, std::log(s0 / strike), expiry, right, delta);
+}
+
+bool MertonOptionPricer::price_grid(double s0, std::span<const double> strikes, OptionRight right,
+                                    std::span<double> prices, std::span<double> deltas) const {
+    AllocationScope alloc_scope;
+    const std::size_t n = expiries_.size() * strikes.size();
+    if (!has_params_ || prices.size() < n || (!deltas.empty() && deltas.size() < n)) {
+        return false;
+    }
+    for (std::size_t k = 0; k < strikes.size(); ++k) {
+        const double log_moneyness = std::log(s0 / strikes[k]);
+        for (std::size_t e = 0; e < expiries_.size(); ++e) {
+            const std::size_t i = e * strikes.size() + k;
+            double delta = 0.0;
+            prices[i] = price_one(s0, strikes[k], log_moneyness, e, right, delta);
+            if (!deltas.empty()) {
+                deltas[i] = delta;
+            }
+        }
+    }
+    return true;
+}
+
+}  // namespace merton
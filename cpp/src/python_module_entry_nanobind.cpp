@@ -1,11 +1,72 @@
+#include "batch_calibrator.hpp"
+#include "calibrator_pool.hpp"
+#include "merton_binding_traits.hpp"
 #include "merton_online_calibrator.hpp"
+#include "merton_option_pricer.hpp"
+#include "quote_engine.hpp"
 #include "reflection_bind_nanobind.hpp"
+#include "shared_params.hpp"
 
 #include <nanobind/nanobind.h>
+#include <nanobind/ndarray.h>
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
 
 namespace nb = nanobind;
 using namespace nb::literals;
 
+namespace {
+
+// Read-only 1-D contiguous host array; viewed in place, never copied.
+template <typename T>
+using CpuVector = nb::ndarray<const T, nb::ndim<1>, nb::c_contig, nb::device::cpu>;
+
+template <typename T>
+std::span<const T> as_span(const CpuVector<T>& a) {
+    return {a.data(), a.shape(0)};
+}
+
+// Writable 1-D contiguous output buffer; bound as noconvert so results land
+// in the caller's array rather than in a temporary copy.
+using CpuOutVector = nb::ndarray<double, nb::ndim<1>, nb::c_contig, nb::device::cpu>;
+
+std::span<double> as_out_span(const CpuOutVector& a) {
+    return {a.data(), a.shape(0)};
+}
+
+// Optional output buffer: None (an invalid ndarray) is an empty span.
+std::span<double> as_optional_out_span(const CpuOutVector& a) {
+    return a.is_valid() ? as_out_span(a) : std::span<double>{};
+}
+
+void check_fair_values(bool ok) {
+    if (!ok) {
+        throw nb::value_error("inputs must have length n or 1 and out at least length n");
+    }
+}
+
+// Read-only NumPy array over a window view; the capsule holds the view's
+// storage reference, so the array stays valid after restore() or the
+// calibrator itself is gone.
+template <typename T>
+nb::ndarray<nb::numpy, const T, nb::ndim<1>> window_array(merton::WindowView<T> view) {
+    auto* owner = new std::shared_ptr<const void>(std::move(view.owner));
+    nb::capsule keep(owner, [](void* p) noexcept { delete static_cast<std::shared_ptr<const void>*>(p); });
+    return nb::ndarray<nb::numpy, const T, nb::ndim<1>>(view.values.data(), {view.values.size()}, keep);
+}
+
+void check_batch_inputs(std::size_t prices, std::size_t epoch_us) {
+    if (prices != epoch_us) {
+        throw nb::value_error("prices and epoch_us must have the same length");
+    }
+}
+
+}  // namespace
+
 NB_MODULE(merton_online_calibrator, m) {
     m.doc() = "Online Merton jump-diffusion calibrator (reflection bindings, nanobind)";
 
@@ -13,11 +74,181 @@ NB_MODULE(merton_online_calibrator, m) {
     p.def(nb::init<>());
     bind_reflected_struct(p);
 
+    m.def("allocation_counting_enabled", &merton::allocation_counting_enabled);
+    m.def("allocation_count", &merton::allocation_count);
+
+    bind_reflected_enum<merton::SearchMode>(m);
+    bind_reflected_enum<merton::OptimizerMode>(m);
+    bind_reflected_enum<merton::MixtureEval>(m);
+    bind_reflected_enum<merton::MixtureKernelWidth>(m);
+    bind_reflected_enum<merton::TickBars>(m);
+
     nb::class_<merton::CalibratorConfig> cfg(m, "CalibratorConfig");
     cfg.def(nb::init<>());
     bind_reflected_struct(cfg);
 
+    nb::class_<merton::LatencySummary> latency(m, "LatencySummary");
+    latency.def(nb::init<>());
+    bind_reflected_struct(latency);
+
+    nb::class_<merton::CalibratorStats> stats(m, "CalibratorStats");
+    stats.def(nb::init<>());
+    bind_reflected_struct(stats);
+
+    nb::class_<merton::TickFilterCounts> filter_counts(m, "TickFilterCounts");
+    filter_counts.def(nb::init<>());
+    bind_reflected_struct(filter_counts);
+
     nb::class_<merton::OnlineMertonCalibrator> cl(m, "OnlineMertonCalibrator");
     cl.def(nb::init<merton::MertonParams, merton::CalibratorConfig>(), "initial"_a, "config"_a = merton::CalibratorConfig{});
     bind_reflected_member_functions(cl);
+    cl.def(
+        "update_ticks",
+        [](merton::OnlineMertonCalibrator& self, CpuVector<double> prices, CpuVector<std::int64_t> epoch_us,
+           bool recalibrate) {
+            if (prices.shape(0) != epoch_us.shape(0)) {
+                throw nb::value_error("prices and epoch_us must have the same length");
+            }
+            nb::gil_scoped_release release;
+            return self.update_ticks(as_span(prices), as_span(epoch_us), recalibrate);
+        },
+        "prices"_a, "epoch_us"_a, "recalibrate"_a = false);
+    cl.def(
+        "fair_values",
+        [](const merton::OnlineMertonCalibrator& self, CpuVector<double> s0, CpuVector<double> q_annual,
+           CpuVector<double> t_years, CpuVector<double> r, CpuOutVector out) {
+            check_fair_values(
+                self.fair_values(as_span(s0), as_span(q_annual), as_span(t_years), as_span(r), as_out_span(out)));
+        },
+        "s0"_a, "q_annual"_a, "t_years"_a, "r"_a, "out"_a.noconvert());
+    cl.def("snapshot", [](merton::OnlineMertonCalibrator& self) {
+        std::vector<std::uint8_t> blob;
+        {
+            nb::gil_scoped_release release;
+            blob = self.snapshot();
+        }
+        return nb::bytes(reinterpret_cast<const char*>(blob.data()), blob.size());
+    });
+    cl.def(
+        "restore",
+        [](merton::OnlineMertonCalibrator& self, nb::bytes blob) {
+            const std::span<const std::uint8_t> view(reinterpret_cast<const std::uint8_t*>(blob.c_str()), blob.size());
+            nb::gil_scoped_release release;
+            return self.restore(view);
+        },
+        "blob"_a);
+    cl.def("window_returns",
+           [](const merton::OnlineMertonCalibrator& self) { return window_array(self.window_returns()); });
+    cl.def("window_dt_us",
+           [](const merton::OnlineMertonCalibrator& self) { return window_array(self.window_dt_us()); });
+    cl.def("window_log_likelihood",
+           [](merton::OnlineMertonCalibrator& self) { return window_array(self.window_log_likelihood()); });
+
+    nb::class_<merton::SharedParams> shared(m, "SharedParams");
+    shared.def(nb::init<>());
+    bind_reflected_struct(shared);
+
+    nb::class_<merton::SharedParamsReader> shared_reader(m, "SharedParamsReader");
+    shared_reader.def(nb::init<std::string>(), "name"_a);
+    bind_reflected_member_functions(shared_reader);
+    m.def("remove_shared_params", &merton::remove_shared_params, "name"_a);
+
+    nb::class_<merton::BatchOptions> batch_options(m, "BatchOptions");
+    batch_options.def(nb::init<>());
+    bind_reflected_struct(batch_options);
+
+    nb::class_<merton::BatchFit> batch_fit(m, "BatchFit");
+    batch_fit.def(nb::init<>());
+    bind_reflected_struct(batch_fit);
+
+    m.def(
+        "calibrate_batch",
+        [](CpuVector<double> prices, CpuVector<std::int64_t> epoch_us, const merton::MertonParams& initial,
+           const merton::CalibratorConfig& config, const merton::BatchOptions& options) {
+            check_batch_inputs(prices.shape(0), epoch_us.shape(0));
+            const std::span<const double> px = as_span(prices);
+            const std::span<const std::int64_t> ts = as_span(epoch_us);
+            nb::gil_scoped_release release;
+            return merton::calibrate_batch(px, ts, initial, config, options);
+        },
+        "prices"_a, "epoch_us"_a, "initial"_a = merton::MertonParams{},
+        "config"_a = merton::CalibratorConfig{}, "options"_a = merton::BatchOptions{});
+    m.def(
+        "calibrate_rolling",
+        [](CpuVector<double> prices, CpuVector<std::int64_t> epoch_us, const merton::MertonParams& initial,
+           const merton::CalibratorConfig& config, const merton::BatchOptions& options) {
+            check_batch_inputs(prices.shape(0), epoch_us.shape(0));
+            const std::span<const double> px = as_span(prices);
+            const std::span<const std::int64_t> ts = as_span(epoch_us);
+            std::vector<merton::BatchFit> fits;
+            {
+                nb::gil_scoped_release release;
+                fits = merton::calibrate_rolling(px, ts, initial, config, options);
+            }
+            return reflected_structured_array(std::span<const merton::BatchFit>(fits));
+        },
+        "prices"_a, "epoch_us"_a, "initial"_a = merton::MertonParams{},
+        "config"_a = merton::CalibratorConfig{}, "options"_a = merton::BatchOptions{});
+
+    nb::class_<merton::QuoteEngineConfig> quote_cfg(m, "QuoteEngineConfig");
+    quote_cfg.def(nb::init<>());
+    bind_reflected_struct(quote_cfg);
+
+    nb::class_<merton::QuoteResult> quote(m, "QuoteResult");
+    quote.def(nb::init<>());
+    bind_reflected_struct(quote);
+
+    nb::class_<merton::QuoteEngine> engine(m, "QuoteEngine");
+    engine.def(nb::init<merton::MertonParams, merton::CalibratorConfig, merton::QuoteEngineConfig>(), "initial"_a,
+               "calibrator_config"_a = merton::CalibratorConfig{}, "config"_a = merton::QuoteEngineConfig{});
+    bind_reflected_member_functions(engine);
+    engine.def("calibrator", &merton::QuoteEngine::calibrator, nb::rv_policy::reference_internal);
+
+    bind_reflected_enum<merton::OptionRight>(m);
+
+    nb::class_<merton::OptionPricerConfig> pricer_cfg(m, "OptionPricerConfig");
+    pricer_cfg.def(nb::init<>());
+    bind_reflected_struct(pricer_cfg);
+
+    nb::class_<merton::MertonOptionPricer> pricer(m, "MertonOptionPricer");
+    pricer.def(nb::init<merton::OptionPricerConfig>(), "config"_a = merton::OptionPricerConfig{});
+    bind_reflected_member_functions(pricer);
+    pricer.def(
+        "set_expiries",
+        [](merton::MertonOptionPricer& self, CpuVector<double> t_years, CpuVector<double> q_annual,
+           CpuVector<double> r) {
+            if (!self.set_expiries(as_span(t_years), as_span(q_annual), as_span(r))) {
+                throw nb::value_error("q_annual and r must have length n or 1");
+            }
+        },
+        "t_years"_a, "q_annual"_a, "r"_a);
+    pricer.def(
+        "price_grid",
+        [](const merton::MertonOptionPricer& self, double s0, CpuVector<double> strikes, merton::OptionRight right,
+           CpuOutVector out, CpuOutVector deltas) {
+            if (!self.price_grid(s0, as_span(strikes), right, as_out_span(out), as_optional_out_span(deltas))) {
+                throw nb::value_error("no params yet, or out / deltas shorter than expiries * strikes");
+            }
+        },
+        "s0"_a, "strikes"_a, "right"_a, "out"_a.noconvert(), "deltas"_a.noconvert().none() = nb::none());
+
+    nb::class_<merton::SymbolStats> sym_stats(m, "SymbolStats");
+    sym_stats.def(nb::init<>());
+    bind_reflected_struct(sym_stats);
+
+    nb::class_<merton::PoolStats> pool_stats(m, "PoolStats");
+    pool_stats.def(nb::init<>());
+    bind_reflected_struct(pool_stats);
+
+    nb::class_<merton::CalibratorPool> pool(m, "CalibratorPool");
+    pool.def(nb::init<merton::CalibratorConfig, std::size_t>(), "config"_a = merton::CalibratorConfig{}, "threads"_a = 0);
+    bind_reflected_member_functions(pool);
+    pool.def(
+        "fair_values",
+        [](const merton::CalibratorPool& self, const std::string& symbol, CpuVector<double> s0,
+           CpuVector<double> q_annual, CpuVector<double> t_years, CpuVector<double> r, CpuOutVector out) {
+            check_fair_values(self.fair_values(symbol, as_span(s0), as_span(q_annual), as_span(t_years), as_span(r),
+                                               as_out_span(out)));
+        },
+        "symbol"_a, "s0"_a, "q_annual"_a, "t_years"_a, "r"_a, "out"_a.noconvert());
 }
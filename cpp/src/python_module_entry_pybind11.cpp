@@ -1,10 +1,89 @@
+#include "batch_calibrator.hpp"
+#include "calibrator_pool.hpp"
+#include "merton_binding_traits.hpp"
 #include "merton_online_calibrator.hpp"
+#include "merton_option_pricer.hpp"
+#include "quote_engine.hpp"
 #include "reflection_bind_pybind11.hpp"
+#include "shared_params.hpp"
 
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
 namespace py = pybind11;
 
+namespace {
+
+// C-contiguous array of T; inputs already matching are viewed in place.
+template <typename T>
+using CpuVector = py::array_t<T, py::array::c_style>;
+
+template <typename T>
+std::span<const T> as_span(const CpuVector<T>& a) {
+    if (a.ndim() != 1) {
+        throw py::value_error("expected a 1-D array");
+    }
+    return {a.data(), static_cast<std::size_t>(a.shape(0))};
+}
+
+// Writable 1-D contiguous output buffer; bound as noconvert so results land
+// in the caller's array rather than in a temporary copy.
+using CpuOutVector = py::array_t<double, py::array::c_style>;
+
+std::span<double> as_out_span(CpuOutVector& a) {
+    if (a.ndim() != 1) {
+        throw py::value_error("expected a 1-D array");
+    }
+    return {a.mutable_data(), static_cast<std::size_t>(a.shape(0))};
+}
+
+// Optional output buffer: None is an empty span; anything else must already
+// be a writable C-contiguous float64 array (no converted copy).
+std::span<double> as_optional_out_span(const py::object& a) {
+    if (a.is_none()) {
+        return {};
+    }
+    if (!CpuOutVector::check_(a)) {
+        throw py::type_error("expected a C-contiguous float64 array or None");
+    }
+    auto array = py::reinterpret_borrow<CpuOutVector>(a);
+    return as_out_span(array);
+}
+
+void check_fair_values(bool ok) {
+    if (!ok) {
+        throw py::value_error("inputs must have length n or 1 and out at least length n");
+    }
+}
+
+// Read-only NumPy array over a window view; the capsule holds the view's
+// storage reference, so the array stays valid after restore() or the
+// calibrator itself is gone.
+template <typename T>
+py::array_t<T> window_array(merton::WindowView<T> view) {
+    auto* owner = new std::shared_ptr<const void>(std::move(view.owner));
+    py::capsule keep(owner, [](void* p) { delete static_cast<std::shared_ptr<const void>*>(p); });
+    py::array_t<T> out({static_cast<py::ssize_t>(view.values.size())}, {static_cast<py::ssize_t>(sizeof(T))},
+                       view.values.data(), keep);
+    out.attr("flags").attr("writeable") = false;
+    return out;
+}
+
+void check_batch_inputs(std::size_t prices, std::size_t epoch_us) {
+    if (prices != epoch_us) {
+        throw py::value_error("prices and epoch_us must have the same length");
+    }
+}
+
+}  // namespace
+
 PYBIND11_MODULE(merton_online_calibrator, m) {
     m.doc() = "Online Merton jump-diffusion calibrator (reflection bindings, pybind11)";
 
@@ -12,11 +91,187 @@ PYBIND11_MODULE(merton_online_calibrator, m) {
     p.def(py::init<>());
     bind_reflected_struct(p);
 
+    m.def("allocation_counting_enabled", &merton::allocation_counting_enabled);
+    m.def("allocation_count", &merton::allocation_count);
+
+    bind_reflected_enum<merton::SearchMode>(m);
+    bind_reflected_enum<merton::OptimizerMode>(m);
+    bind_reflected_enum<merton::MixtureEval>(m);
+    bind_reflected_enum<merton::MixtureKernelWidth>(m);
+    bind_reflected_enum<merton::TickBars>(m);
+
     py::class_<merton::CalibratorConfig> cfg(m, "CalibratorConfig");
     cfg.def(py::init<>());
     bind_reflected_struct(cfg);
 
+    py::class_<merton::LatencySummary> latency(m, "LatencySummary");
+    latency.def(py::init<>());
+    bind_reflected_struct(latency);
+
+    py::class_<merton::CalibratorStats> stats(m, "CalibratorStats");
+    stats.def(py::init<>());
+    bind_reflected_struct(stats);
+
+    py::class_<merton::TickFilterCounts> filter_counts(m, "TickFilterCounts");
+    filter_counts.def(py::init<>());
+    bind_reflected_struct(filter_counts);
+
     py::class_<merton::OnlineMertonCalibrator> cl(m, "OnlineMertonCalibrator");
     cl.def(py::init<merton::MertonParams, merton::CalibratorConfig>(), py::arg("initial"), py::arg("config") = merton::CalibratorConfig{});
     bind_reflected_member_functions(cl);
+    cl.def(
+        "update_ticks",
+        [](merton::OnlineMertonCalibrator& self, CpuVector<double> prices, CpuVector<std::int64_t> epoch_us,
+           bool recalibrate) {
+            const std::span<const double> px = as_span(prices);
+            const std::span<const std::int64_t> ts = as_span(epoch_us);
+            if (px.size() != ts.size()) {
+                throw py::value_error("prices and epoch_us must have the same length");
+            }
+            py::gil_scoped_release release;
+            return self.update_ticks(px, ts, recalibrate);
+        },
+        py::arg("prices"), py::arg("epoch_us"), py::arg("recalibrate") = false);
+    cl.def(
+        "fair_values",
+        [](const merton::OnlineMertonCalibrator& self, CpuVector<double> s0, CpuVector<double> q_annual,
+           CpuVector<double> t_years, CpuVector<double> r, CpuOutVector out) {
+            check_fair_values(
+                self.fair_values(as_span(s0), as_span(q_annual), as_span(t_years), as_span(r), as_out_span(out)));
+        },
+        py::arg("s0"), py::arg("q_annual"), py::arg("t_years"), py::arg("r"), py::arg("out").noconvert());
+    cl.def("snapshot", [](merton::OnlineMertonCalibrator& self) {
+        std::vector<std::uint8_t> blob;
+        {
+            py::gil_scoped_release release;
+            blob = self.snapshot();
+        }
+        return py::bytes(reinterpret_cast<const char*>(blob.data()), blob.size());
+    });
+    cl.def(
+        "restore",
+        [](merton::OnlineMertonCalibrator& self, py::bytes blob) {
+            const std::string_view bytes = blob;
+            const std::span<const std::uint8_t> view(reinterpret_cast<const std::uint8_t*>(bytes.data()), bytes.size());
+            py::gil_scoped_release release;
+            return self.restore(view);
+        },
+        py::arg("blob"));
+    cl.def("window_returns",
+           [](const merton::OnlineMertonCalibrator& self) { return window_array(self.window_returns()); });
+    cl.def("window_dt_us",
+           [](const merton::OnlineMertonCalibrator& self) { return window_array(self.window_dt_us()); });
+    cl.def("window_log_likelihood",
+           [](merton::OnlineMertonCalibrator& self) { return window_array(self.window_log_likelihood()); });
+
+    py::class_<merton::SharedParams> shared(m, "SharedParams");
+    shared.def(py::init<>());
+    bind_reflected_struct(shared);
+
+    py::class_<merton::SharedParamsReader> shared_reader(m, "SharedParamsReader");
+    shared_reader.def(py::init<std::string>(), py::arg("name"));
+    bind_reflected_member_functions(shared_reader);
+    m.def("remove_shared_params", &merton::remove_shared_params, py::arg("name"));
+
+    py::class_<merton::BatchOptions> batch_options(m, "BatchOptions");
+    batch_options.def(py::init<>());
+    bind_reflected_struct(batch_options);
+
+    py::class_<merton::BatchFit> batch_fit(m, "BatchFit");
+    batch_fit.def(py::init<>());
+    bind_reflected_struct(batch_fit);
+
+    m.def(
+        "calibrate_batch",
+        [](CpuVector<double> prices, CpuVector<std::int64_t> epoch_us, const merton::MertonParams& initial,
+           const merton::CalibratorConfig& config, const merton::BatchOptions& options) {
+            const std::span<const double> px = as_span(prices);
+            const std::span<const std::int64_t> ts = as_span(epoch_us);
+            check_batch_inputs(px.size(), ts.size());
+            py::gil_scoped_release release;
+            return merton::calibrate_batch(px, ts, initial, config, options);
+        },
+        py::arg("prices"), py::arg("epoch_us"), py::arg("initial") = merton::MertonParams{},
+        py::arg("config") = merton::CalibratorConfig{}, py::arg("options") = merton::BatchOptions{});
+    m.def(
+        "calibrate_rolling",
+        [](CpuVector<double> prices, CpuVector<std::int64_t> epoch_us, const merton::MertonParams& initial,
+           const merton::CalibratorConfig& config, const merton::BatchOptions& options) {
+            const std::span<const double> px = as_span(prices);
+            const std::span<const std::int64_t> ts = as_span(epoch_us);
+            check_batch_inputs(px.size(), ts.size());
+            std::vector<merton::BatchFit> fits;
+            {
+                py::gil_scoped_release release;
+                fits = merton::calibrate_rolling(px, ts, initial, config, options);
+            }
+            return reflected_structured_array(std::span<const merton::BatchFit>(fits));
+        },
+        py::arg("prices"), py::arg("epoch_us"), py::arg("initial") = merton::MertonParams{},
+        py::arg("config") = merton::CalibratorConfig{}, py::arg("options") = merton::BatchOptions{});
+
+    py::class_<merton::QuoteEngineConfig> quote_cfg(m, "QuoteEngineConfig");
+    quote_cfg.def(py::init<>());
+    bind_reflected_struct(quote_cfg);
+
+    py::class_<merton::QuoteResult> quote(m, "QuoteResult");
+    quote.def(py::init<>());
+    bind_reflected_struct(quote);
+
+    py::class_<merton::QuoteEngine> engine(m, "QuoteEngine");
+    engine.def(py::init<merton::MertonParams, merton::CalibratorConfig, merton::QuoteEngineConfig>(),
+               py::arg("initial"), py::arg("calibrator_config") = merton::CalibratorConfig{},
+               py::arg("config") = merton::QuoteEngineConfig{});
+    bind_reflected_member_functions(engine);
+    engine.def("calibrator", &merton::QuoteEngine::calibrator, py::return_value_policy::reference_internal);
+
+    bind_reflected_enum<merton::OptionRight>(m);
+
+    py::class_<merton::OptionPricerConfig> pricer_cfg(m, "OptionPricerConfig");
+    pricer_cfg.def(py::init<>());
+    bind_reflected_struct(pricer_cfg);
+
+    py::class_<merton::MertonOptionPricer> pricer(m, "MertonOptionPricer");
+    pricer.def(py::init<merton::OptionPricerConfig>(), py::arg("config") = merton::OptionPricerConfig{});
+    bind_reflected_member_functions(pricer);
+    pricer.def(
+        "set_expiries",
+        [](merton::MertonOptionPricer& self, CpuVector<double> t_years, CpuVector<double> q_annual,
+           CpuVector<double> r) {
+            if (!self.set_expiries(as_span(t_years), as_span(q_annual), as_span(r))) {
+                throw py::value_error("q_annual and r must have length n or 1");
+            }
+        },
+        py::arg("t_years"), py::arg("q_annual"), py::arg("r"));
+    pricer.def(
+        "price_grid",
+        [](const merton::MertonOptionPricer& self, double s0, CpuVector<double> strikes, merton::OptionRight right,
+           CpuOutVector out, const py::object& deltas) {
+            if (!self.price_grid(s0, as_span(strikes), right, as_out_span(out), as_optional_out_span(deltas))) {
+                throw py::value_error("no params yet, or out / deltas shorter than expiries * strikes");
+            }
+        },
+        py::arg("s0"), py::arg("strikes"), py::arg("right"), py::arg("out").noconvert(),
+        py::arg("deltas") = py::none());
+
+    py::class_<merton::SymbolStats> sym_stats(m, "SymbolStats");
+    sym_stats.def(py::init<>());
+    bind_reflected_struct(sym_stats);
+
+    py::class_<merton::PoolStats> pool_stats(m, "PoolStats");
+    pool_stats.def(py::init<>());
+    bind_reflected_struct(pool_stats);
+
+    py::class_<merton::CalibratorPool> pool(m, "CalibratorPool");
+    pool.def(py::init<merton::CalibratorConfig, std::size_t>(), py::arg("config") = merton::CalibratorConfig{}, py::arg("threads") = 0);
+    bind_reflected_member_functions(pool);
+    pool.def(
+        "fair_values",
+        [](const merton::CalibratorPool& self, const std::string& symbol, CpuVector<double> s0,
+           CpuVector<double> q_annual, CpuVector<double> t_years, CpuVector<double> r, CpuOutVector out) {
+            check_fair_values(self.fair_values(symbol, as_span(s0), as_span(q_annual), as_span(t_years), as_span(r),
+                                               as_out_span(out)));
+        },
+        py::arg("symbol"), py::arg("s0"), py::arg("q_annual"), py::arg("t_years"), py::arg("r"),
+        py::arg("out").noconvert());
 }
@@ -0,0 +1,101 @@
+// -----------------------------------------------------------------------------
+// quantlib_curves.cpp
+// -----------------------------------------------------------------------------
+//
+// Cached QuantLib discount curves behind RelinkableHandles (see
+// quantlib_curves.hpp). Per call:
+//   1. roll_date(): at most once per second, re-read Date::todaysDate(); on a
+//      new day set Settings::evaluationDate and rebuild the flat curves
+//   2. push r / q into the SimpleQuotes (no-op when unchanged)
+//   3. F = S0 * Dq(T) / Dr(T) through the handles
+// -----------------------------------------------------------------------------
+
+#include "quantlib_curves.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include <ql/settings.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
+
+namespace merton {
+
+namespace {
+
+// How stale the cached "today" may get before Date::todaysDate() is re-read.
+constexpr auto kDateCheckInterval = std::chrono::seconds(1);
+
+QuantLib::ext::shared_ptr<QuantLib::YieldTermStructure> flat_curve(
+    const QuantLib::Date& today, const QuantLib::ext::shared_ptr<QuantLib::SimpleQuote>& rate,
+    const QuantLib::DayCounter& dc) {
+    return QuantLib::ext::make_shared<QuantLib::FlatForward>(
+        today, QuantLib::Handle<QuantLib::Quote>(rate), dc);
+}
+
+}  // namespace
+
+QuantLibCarryCurves::QuantLibCarryCurves()
+    : r_quote_(QuantLib::ext::make_shared<QuantLib::SimpleQuote>(0.0)),
+      q_quote_(QuantLib::ext::make_shared<QuantLib::SimpleQuote>(0.0)) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    roll_date();
+}
+
+double QuantLibCarryCurves::forward(double s0, double q_annual, double r, double t_years, double& t_out) {
+    using namespace QuantLib;
+    std::lock_guard<std::mutex> lock(mutex_);
+    roll_date();
+    if (!r_linked_) {
+        r_quote_->setValue(r);
+    }
+    if (!q_linked_) {
+        q_quote_->setValue(q_annual);
+    }
+
+    const Integer days = std::max<Integer>(1, static_cast<Integer>(std::llround(std::max(t_years, 1e-8) * 365.25)));
+    const Date maturity = today_ + days;
+    t_out = day_counter_.yearFraction(today_, maturity);
+    if (!(t_out > 0.0)) {
+        return s0;
+    }
+    return s0 * (q_curve_->discount(maturity) / r_curve_->discount(maturity));
+}
+
+void QuantLibCarryCurves::link_rate_curve(const QuantLib::ext::shared_ptr<QuantLib::YieldTermStructure>& curve) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    r_linked_ = curve;
+    r_curve_.linkTo(curve ? curve : flat_curve(today_, r_quote_, day_counter_));
+}
+
+void QuantLibCarryCurves::link_carry_curve(const QuantLib::ext::shared_ptr<QuantLib::YieldTermStructure>& curve) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    q_linked_ = curve;
+    q_curve_.linkTo(curve ? curve : flat_curve(today_, q_quote_, day_counter_));
+}
+
+/// Caller holds mutex_.
+void QuantLibCarryCurves::roll_date() {
+    using namespace QuantLib;
+    const auto now = std::chrono::steady_clock::now();
+    if (now < next_date_check_) {
+        return;
+    }
+    next_date_check_ = now + kDateCheckInterval;
+
+    const Date today = Date::todaysDate();
+    if (Date(Settings::instance().evaluationDate()) != today) {
+        Settings::instance().evaluationDate() = today;
+    }
+    if (today == today_ && !r_curve_.empty()) {
+        return;
+    }
+    today_ = today;
+    if (!r_linked_) {
+        r_curve_.linkTo(flat_curve(today_, r_quote_, day_counter_));
+    }
+    if (!q_linked_) {
+        q_curve_.linkTo(flat_curve(today_, q_quote_, day_counter_));
+    }
+}
+
+}  // namespace merton
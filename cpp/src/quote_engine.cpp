@@ -0,0 +1,67 @@
+// -----------------------------------------------------------------------------
+// quote_engine.cpp
+// -----------------------------------------------------------------------------
+//
+// One-call quote path on top of OnlineMertonCalibrator (see quote_engine.hpp):
+//   mid        = (bid + ask) / 2
+//   update_tick(mid, ts); maybe_update_params() (sync: only after an accepted
+//   return; async: polls the published version)
+//   theo       = fair_value(mid, funding_annual(rate), horizon, r)
+//   diff_bps   = (theo - mid) / mid * 1e4
+//   half       = max(theo * min_half_spread_bps / 1e4, max((ask - bid) / 2, 0))
+//   quote      = [theo - half, theo + half]
+// -----------------------------------------------------------------------------
+
+#include "quote_engine.hpp"
+
+#include <algorithm>
+
+namespace merton {
+
+namespace {
+
+constexpr double kHoursPerYear = 365.25 * 24.0;
+constexpr double kBps = 1e-4;
+
+}  // namespace
+
+QuoteEngine::QuoteEngine(MertonParams initial, CalibratorConfig calibrator_config, QuoteEngineConfig config)
+    : calibrator_(initial, calibrator_config),
+      config_(config),
+      funding_periods_per_year_(config.funding_interval_hours > 0.0 ? kHoursPerYear / config.funding_interval_hours
+                                                                    : 0.0),
+      min_half_spread_(std::max(config.min_half_spread_bps, 0.0) * kBps),
+      last_version_(calibrator_.params_version()) {}
+
+QuoteResult QuoteEngine::on_quote(double bid, double ask, std::int64_t epoch_us, double funding_rate) {
+    QuoteResult out;
+    on_quote_into(bid, ask, epoch_us, funding_rate, out);
+    return out;
+}
+
+bool QuoteEngine::on_quote_into(double bid, double ask, std::int64_t epoch_us, double funding_rate,
+                                QuoteResult& out) {
+    AllocationScope alloc_scope;
+    out = QuoteResult{};
+    if (!(bid > 0.0) || !(ask > 0.0)) {
+        return false;
+    }
+    out.valid = true;
+    out.mid = 0.5 * (bid + ask);
+    out.tick_accepted = calibrator_.update_tick(out.mid, epoch_us);
+    if (out.tick_accepted || calibrator_.is_async()) {
+        calibrator_.maybe_update_params();
+    }
+    out.params_version = calibrator_.params_version();
+    out.params_updated = out.params_version != last_version_;
+    last_version_ = out.params_version;
+
+    out.theo = calibrator_.fair_value(out.mid, funding_annual(funding_rate), config_.horizon_years, config_.rate);
+    out.diff_bps = (out.theo - out.mid) / out.mid / kBps;
+    const double half = std::max(out.theo * min_half_spread_, std::max(0.5 * (ask - bid), 0.0));
+    out.quote_bid = out.theo - half;
+    out.quote_ask = out.theo + half;
+    return true;
+}
+
+}  // namespace merton
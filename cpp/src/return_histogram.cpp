@@ -0,0 +1,129 @@
+// -----------------------------------------------------------------------------
+// return_histogram.cpp
+// -----------------------------------------------------------------------------
+//
+// Sorted flat map key -> (value, count) over the rolling window returns.
+// Quote-driven mids move in whole ticks, so a 4096-point window typically
+// holds only tens to a few hundred distinct returns. Keys are kept sorted in
+// contiguous arrays (binary search + shift); capacity is reserved up front so
+// add/remove never allocate.
+//
+// DtBucketedHistogram splits the same structure by dt bucket; its
+// per-bucket maps only reserve as they grow.
+// -----------------------------------------------------------------------------
+
+#include "return_histogram.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <iterator>
+
+namespace merton {
+
+ReturnHistogram::ReturnHistogram(double quantum, std::size_t capacity)
+    : quantum_(quantum) {
+    keys_.reserve(capacity);
+    values_.reserve(capacity);
+    counts_.reserve(capacity);
+}
+
+/// Quantized key: nearest multiple of quantum, or the raw bit pattern in
+/// exact mode (any consistent total order is enough for the sorted map).
+std::int64_t ReturnHistogram::key_of(double r) const {
+    if (r == 0.0) {
+        r = 0.0;  // fold -0.0 into +0.0
+    }
+    if (quantum_ > 0.0) {
+        return static_cast<std::int64_t>(std::llround(r / quantum_));
+    }
+    return std::bit_cast<std::int64_t>(r);
+}
+
+/// Representative value for a bucket: the bucket centre, or r itself in exact mode.
+double ReturnHistogram::value_of(std::int64_t key, double r) const {
+    if (quantum_ > 0.0) {
+        return static_cast<double>(key) * quantum_;
+    }
+    return r == 0.0 ? 0.0 : r;
+}
+
+void ReturnHistogram::add(double r) {
+    const std::int64_t key = key_of(r);
+    const auto it = std::lower_bound(keys_.begin(), keys_.end(), key);
+    const auto i = static_cast<std::size_t>(std::distance(keys_.begin(), it));
+    if (it != keys_.end() && *it == key) {
+        counts_[i] += 1.0;
+    } else {
+        keys_.insert(it, key);
+        values_.insert(values_.begin() + static_cast<std::ptrdiff_t>(i), value_of(key, r));
+        counts_.insert(counts_.begin() + static_cast<std::ptrdiff_t>(i), 1.0);
+    }
+    ++total_;
+}
+
+void ReturnHistogram::remove(double r) {
+    const std::int64_t key = key_of(r);
+    const auto it = std::lower_bound(keys_.begin(), keys_.end(), key);
+    if (it == keys_.end() || *it != key) {
+        return;
+    }
+    const auto i = static_cast<std::size_t>(std::distance(keys_.begin(), it));
+    counts_[i] -= 1.0;
+    if (counts_[i] <= 0.0) {
+        keys_.erase(it);
+        values_.erase(values_.begin() + static_cast<std::ptrdiff_t>(i));
+        counts_.erase(counts_.begin() + static_cast<std::ptrdiff_t>(i));
+    }
+    --total_;
+}
+
+void ReturnHistogram::clear() {
+    keys_.clear();
+    values_.clear();
+    counts_.clear();
+    total_ = 0;
+}
+
+// -----------------------------------------------------------------------------
+// DtBucketedHistogram
+// -----------------------------------------------------------------------------
+
+DtBucketedHistogram::DtBucketedHistogram(double quantum, unsigned sub_bits, unsigned max_bits)
+    : layout_{std::min({sub_bits, kMaxDtBucketSubBits, max_bits}), max_bits},
+      buckets_(layout_.count(), ReturnHistogram(quantum, 0)) {}
+
+std::size_t DtBucketedHistogram::bucket_of(std::int64_t dt_us) const {
+    return layout_.index(dt_us > 0 ? static_cast<std::uint64_t>(dt_us) : 0);
+}
+
+void DtBucketedHistogram::add(double r, std::int64_t dt_us) {
+    buckets_[bucket_of(dt_us)].add(r);
+    ++total_;
+}
+
+void DtBucketedHistogram::remove(double r, std::int64_t dt_us) {
+    ReturnHistogram& h = buckets_[bucket_of(dt_us)];
+    if (h.total() == 0) {
+        return;
+    }
+    h.remove(r);
+    --total_;
+}
+
+void DtBucketedHistogram::clear() {
+    for (ReturnHistogram& h : buckets_) {
+        h.clear();
+    }
+    total_ = 0;
+}
+
+std::size_t DtBucketedHistogram::active_buckets() const {
+    std::size_t n = 0;
+    for (const ReturnHistogram& h : buckets_) {
+        n += h.total() > 0 ? 1 : 0;
+    }
+    return n;
+}
+
+}  // namespace merton
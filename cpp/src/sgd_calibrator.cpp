@@ -0,0 +1,64 @@
+// -----------------------------------------------------------------------------
+// sgd_calibrator.cpp
+// -----------------------------------------------------------------------------
+//
+// Per-return Adam step for the Merton params (see sgd_calibrator.hpp). With g
+// the NLL gradient of the latest return in box units (g_i * (upper_i - lower_i)):
+//   m <- b1*m + (1-b1)*g,  v <- b2*v + (1-b2)*g^2,  b2 = 1 - 1/memory
+//   p_i <- p_i - lr * span_i * m^ / (sqrt(v^) + eps)
+// where m^, v^ are the bias-corrected moments. Normalizing by sqrt(v) keeps
+// a jump return, whose raw gradient can be orders of magnitude above a
+// diffusion return's, from throwing the params across the box: the step per
+// return is at most about lr box widths.
+// -----------------------------------------------------------------------------
+
+#include "sgd_calibrator.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace merton {
+
+namespace {
+
+// Keeps the step finite while all gradients seen so far are zero.
+constexpr double kSecondMomentEps = 1e-12;
+
+}  // namespace
+
+SgdMertonCalibrator::SgdMertonCalibrator(const MertonParams& lower, const MertonParams& upper, SgdOptions options)
+    : span_{upper.sigma - lower.sigma, upper.lambda - lower.lambda, upper.mu_j - lower.mu_j,
+            upper.delta_j - lower.delta_j},
+      options_(options),
+      second_decay_(1.0 - 1.0 / static_cast<double>(std::max<std::size_t>(options.memory, 2))) {}
+
+MertonParams SgdMertonCalibrator::step(const MertonParams& p, const MertonParams& grad) {
+    const std::array<double, 4> g{grad.sigma, grad.lambda, grad.mu_j, grad.delta_j};
+    if (!std::isfinite(g[0]) || !std::isfinite(g[1]) || !std::isfinite(g[2]) || !std::isfinite(g[3])) {
+        return p;
+    }
+    std::array<double, 4> x{p.sigma, p.lambda, p.mu_j, p.delta_j};
+
+    ++steps_;
+    m_scale_ *= options_.momentum;
+    v_scale_ *= second_decay_;
+    for (std::size_t i = 0; i < 4; ++i) {
+        const double gu = g[i] * span_[i];
+        m_[i] = options_.momentum * m_[i] + (1.0 - options_.momentum) * gu;
+        v_[i] = second_decay_ * v_[i] + (1.0 - second_decay_) * gu * gu;
+        const double m_hat = m_[i] / (1.0 - m_scale_);
+        const double v_hat = v_[i] / (1.0 - v_scale_);
+        x[i] -= options_.learning_rate * span_[i] * m_hat / (std::sqrt(v_hat) + kSecondMomentEps);
+    }
+    return MertonParams{x[0], x[1], x[2], x[3]};
+}
+
+void SgdMertonCalibrator::reset() {
+    m_.fill(0.0);
+    v_.fill(0.0);
+    m_scale_ = 1.0;
+    v_scale_ = 1.0;
+    steps_ = 0;
+}
+
+}  // namespace merton
@@ -0,0 +1,171 @@
+// -----------------------------------------------------------------------------
+// shared_params.cpp
+// -----------------------------------------------------------------------------
+//
+// Cross-process publication of calibrator state (see shared_params.hpp).
+// The segment is one SharedSegment: a header, then the repo's Seqlock over
+// SharedParams. Seqlock keeps its sequence and payload in lock-free 64-bit
+// atomics, which are address-free, so the same protocol works between
+// processes mapping the segment at different addresses.
+//
+// The publisher initializes a segment without the magic (new, or never
+// finished) and sets the magic last, so a reader never sees a half-
+// initialized header; a segment with a valid header is reused as is,
+// keeping its sequence counting up across publisher restarts.
+// -----------------------------------------------------------------------------
+
+#include "shared_params.hpp"
+
+#include "seqlock.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <new>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace merton {
+
+namespace {
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "shared seqlock needs address-free atomics");
+
+constexpr char kSharedMagic[8] = {'M', 'R', 'T', 'N', 'S', 'H', 'M', '1'};
+
+struct SharedSegment {
+    char magic[8];
+    std::uint32_t payload_size;  // sizeof(SharedParams)
+    std::uint32_t reserved;
+    Seqlock<SharedParams> record;
+};
+
+bool header_valid(const SharedSegment& seg) {
+    if (std::memcmp(seg.magic, kSharedMagic, sizeof(kSharedMagic)) != 0) {
+        return false;
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return seg.payload_size == sizeof(SharedParams);
+}
+
+/// Maps fd's SharedSegment, or nullptr if it has another size.
+void* map_segment(int fd, int prot) {
+    struct stat st {};
+    if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) != sizeof(SharedSegment)) {
+        return nullptr;
+    }
+    void* p = ::mmap(nullptr, sizeof(SharedSegment), prot, MAP_SHARED, fd, 0);
+    return p == MAP_FAILED ? nullptr : p;
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+// Publisher
+// -----------------------------------------------------------------------------
+
+SharedParamsPublisher::~SharedParamsPublisher() {
+    close();
+}
+
+bool SharedParamsPublisher::open(const std::string& name) {
+    close();
+    const int fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st {};
+    const bool created = ::fstat(fd, &st) == 0 && st.st_size == 0;
+    if (created && ::ftruncate(fd, sizeof(SharedSegment)) != 0) {
+        ::close(fd);
+        return false;
+    }
+    void* p = map_segment(fd, PROT_READ | PROT_WRITE);
+    ::close(fd);
+    if (p == nullptr) {
+        return false;
+    }
+
+    auto* seg = static_cast<SharedSegment*>(p);
+    if (std::memcmp(seg->magic, kSharedMagic, sizeof(kSharedMagic)) != 0) {
+        // New (ftruncate zero-fills) or left uninitialized by a publisher
+        // that died in open().
+        new (&seg->record) Seqlock<SharedParams>();
+        seg->payload_size = sizeof(SharedParams);
+        seg->reserved = 0;
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(seg->magic, kSharedMagic, sizeof(kSharedMagic));
+    } else if (!header_valid(*seg)) {
+        ::munmap(p, sizeof(SharedSegment));
+        return false;
+    }
+    segment_ = p;
+    return true;
+}
+
+void SharedParamsPublisher::close() {
+    if (segment_) {
+        ::munmap(segment_, sizeof(SharedSegment));
+        segment_ = nullptr;
+    }
+}
+
+void SharedParamsPublisher::store(const SharedParams& value) {
+    if (segment_) {
+        static_cast<SharedSegment*>(segment_)->record.store(value);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Reader
+// -----------------------------------------------------------------------------
+
+SharedParamsReader::SharedParamsReader(const std::string& name) {
+    const int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        return;
+    }
+    void* p = map_segment(fd, PROT_READ);
+    ::close(fd);
+    if (p == nullptr) {
+        return;
+    }
+    if (!header_valid(*static_cast<const SharedSegment*>(p))) {
+        ::munmap(p, sizeof(SharedSegment));
+        return;
+    }
+    segment_ = p;
+}
+
+SharedParamsReader::~SharedParamsReader() {
+    if (segment_) {
+        ::munmap(const_cast<void*>(segment_), sizeof(SharedSegment));
+    }
+}
+
+SharedParams SharedParamsReader::read() const {
+    SharedParams out;
+    read_into(out);
+    return out;
+}
+
+std::uint64_t SharedParamsReader::read_into(SharedParams& out) const {
+    if (!segment_) {
+        return 0;
+    }
+    std::uint64_t sequence = 0;
+    out = static_cast<const SharedSegment*>(segment_)->record.load(sequence);
+    return sequence;
+}
+
+std::uint64_t SharedParamsReader::sequence() const {
+    return segment_ ? static_cast<const SharedSegment*>(segment_)->record.version() : 0;
+}
+
+bool remove_shared_params(const std::string& name) {
+    return ::shm_unlink(name.c_str()) == 0;
+}
+
+}  // namespace merton
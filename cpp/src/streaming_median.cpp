@@ -0,0 +1,67 @@
+// -----------------------------------------------------------------------------
+// streaming_median.cpp
+// -----------------------------------------------------------------------------
+//
+// Rolling order statistic over bucketed microsecond dts. The Fenwick tree
+// holds per-bucket counts; the k-th smallest element is found by binary
+// lifting over the tree in O(log buckets). With the defaults (10 sub-bucket
+// bits, values up to 2^40 us ~ 12.7 days) the tree has 31744 buckets.
+// -----------------------------------------------------------------------------
+
+#include "streaming_median.hpp"
+
+#include <algorithm>
+#include <bit>
+
+namespace merton {
+
+StreamingMedian::StreamingMedian(unsigned sub_bits, unsigned max_bits)
+    : buckets_{sub_bits, max_bits},
+      tree_(buckets_.count() + 1, 0),
+      top_bit_(std::bit_floor(buckets_.count())) {}
+
+void StreamingMedian::bump(std::size_t idx, std::int32_t delta) {
+    for (std::size_t i = idx + 1; i < tree_.size(); i += i & (~i + 1)) {
+        tree_[i] = static_cast<std::uint32_t>(static_cast<std::int64_t>(tree_[i]) + delta);
+    }
+}
+
+void StreamingMedian::add(std::int64_t v) {
+    bump(buckets_.index(v > 0 ? static_cast<std::uint64_t>(v) : 0), +1);
+    ++size_;
+}
+
+void StreamingMedian::remove(std::int64_t v) {
+    if (size_ == 0) {
+        return;
+    }
+    bump(buckets_.index(v > 0 ? static_cast<std::uint64_t>(v) : 0), -1);
+    --size_;
+}
+
+void StreamingMedian::clear() {
+    std::fill(tree_.begin(), tree_.end(), 0);
+    size_ = 0;
+}
+
+/// Bucket index holding the k-th smallest element (0-based), k < size_.
+std::size_t StreamingMedian::kth(std::size_t k) const {
+    std::size_t pos = 0;
+    for (std::size_t step = top_bit_; step > 0; step >>= 1) {
+        const std::size_t next = pos + step;
+        if (next < tree_.size() && tree_[next] <= k) {
+            pos = next;
+            k -= tree_[next];
+        }
+    }
+    return pos;  // 1-based prefix end == 0-based bucket index
+}
+
+std::int64_t StreamingMedian::median() const {
+    if (size_ == 0) {
+        return 0;
+    }
+    return static_cast<std::int64_t>(buckets_.representative(kth(size_ / 2)));
+}
+
+}  // namespace merton
@@ -0,0 +1,130 @@
+// -----------------------------------------------------------------------------
+// thread_pool.cpp
+// -----------------------------------------------------------------------------
+//
+// Work-stealing pool: one mutex-guarded task ring per worker. Owners pop from the
+// back, thieves take from the front. submit() raises queued_ (with
+// wake_mutex_ held) before the task is pushed, so a pop can never take
+// queued_ below zero; a pop raises running_ before it lowers queued_ (release,
+// read with acquire), so queued_ == 0 && running_ == 0 is never seen while a
+// task is outstanding. Task completion lowers running_ and signals idle_ with
+// wake_mutex_ held, so sleeping workers and wait_idle() never miss a
+// transition.
+// -----------------------------------------------------------------------------
+
+#include "thread_pool.hpp"
+
+#include <algorithm>
+
+namespace merton {
+
+namespace {
+
+// Identifies the pool/worker executing the current thread (for local submit).
+thread_local const ThreadPool* tls_pool = nullptr;
+thread_local std::size_t tls_worker = 0;
+
+}  // namespace
+
+ThreadPool::ThreadPool(std::size_t threads) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    workers_.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+    threads_.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) {
+        threads_.emplace_back([this, i] { run(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& t : threads_) {
+        t.join();
+    }
+}
+
+void ThreadPool::submit(Task task) {
+    const std::size_t target = tls_pool == this
+        ? tls_worker
+        : next_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        queued_.fetch_add(1, std::memory_order_relaxed);
+    }
+    {
+        std::lock_guard<std::mutex> lock(workers_[target]->mutex);
+        workers_[target]->tasks.push_back(std::move(task));
+    }
+    wake_.notify_one();
+}
+
+void ThreadPool::wait_idle() {
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+    idle_.wait(lock, [this] {
+        return queued_.load(std::memory_order_acquire) == 0 && running_.load(std::memory_order_relaxed) == 0;
+    });
+}
+
+bool ThreadPool::try_pop_local(std::size_t self, Task& out) {
+    Worker& w = *workers_[self];
+    std::lock_guard<std::mutex> lock(w.mutex);
+    if (w.tasks.empty()) {
+        return false;
+    }
+    out = w.tasks.pop_back();
+    running_.fetch_add(1, std::memory_order_relaxed);
+    queued_.fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+bool ThreadPool::try_steal(std::size_t self, Task& out) {
+    const std::size_t n = workers_.size();
+    for (std::size_t k = 1; k < n; ++k) {
+        Worker& victim = *workers_[(self + k) % n];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.tasks.empty()) {
+            continue;
+        }
+        out = victim.tasks.pop_front();
+        running_.fetch_add(1, std::memory_order_relaxed);
+        queued_.fetch_sub(1, std::memory_order_release);
+        stolen_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::run(std::size_t self) {
+    tls_pool = this;
+    tls_worker = self;
+
+    Task task;
+    for (;;) {
+        if (try_pop_local(self, task) || try_steal(self, task)) {
+            task();
+            task = nullptr;
+            completed_.fetch_add(1, std::memory_order_relaxed);
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+            running_.fetch_sub(1, std::memory_order_relaxed);
+            if (queued_.load(std::memory_order_acquire) == 0 && running_.load(std::memory_order_relaxed) == 0) {
+                idle_.notify_all();
+            }
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        wake_.wait(lock, [this] { return stop_ || queued_.load(std::memory_order_relaxed) > 0; });
+        if (stop_ && queued_.load(std::memory_order_relaxed) == 0) {
+            return;
+        }
+    }
+}
+
+}  // namespace merton
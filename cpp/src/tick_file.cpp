@@ -0,0 +1,102 @@
+// -----------------------------------------------------------------------------
+// tick_file.cpp
+// -----------------------------------------------------------------------------
+//
+// Raw tick files are mapped read-only with MAP_PRIVATE and advised for
+// sequential access, so a replay streams straight from the page cache
+// without copying. Empty files map to an empty span.
+// -----------------------------------------------------------------------------
+
+#include "tick_file.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace merton {
+
+MappedTickFile::~MappedTickFile() {
+    close();
+}
+
+MappedTickFile::MappedTickFile(MappedTickFile&& other) noexcept
+    : open_(std::exchange(other.open_, false)),
+      base_(std::exchange(other.base_, nullptr)),
+      bytes_(std::exchange(other.bytes_, 0)),
+      data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)) {}
+
+MappedTickFile& MappedTickFile::operator=(MappedTickFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        open_ = std::exchange(other.open_, false);
+        base_ = std::exchange(other.base_, nullptr);
+        bytes_ = std::exchange(other.bytes_, 0);
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+}
+
+bool MappedTickFile::open(const std::string& path) {
+    close();
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st {};
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        return false;
+    }
+    const auto bytes = static_cast<std::size_t>(st.st_size);
+    if (bytes % sizeof(TickRecord) != 0) {
+        ::close(fd);
+        errno = EINVAL;
+        return false;
+    }
+    if (bytes == 0) {
+        ::close(fd);
+        open_ = true;
+        return true;
+    }
+    void* base = ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        return false;
+    }
+    ::madvise(base, bytes, MADV_SEQUENTIAL);
+    open_ = true;
+    base_ = base;
+    bytes_ = bytes;
+    data_ = static_cast<const TickRecord*>(base);
+    size_ = bytes / sizeof(TickRecord);
+    return true;
+}
+
+void MappedTickFile::close() {
+    if (base_ != nullptr) {
+        ::munmap(base_, bytes_);
+    }
+    open_ = false;
+    base_ = nullptr;
+    bytes_ = 0;
+    data_ = nullptr;
+    size_ = 0;
+}
+
+bool write_tick_file(const std::string& path, std::span<const TickRecord> ticks) {
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    if (f == nullptr) {
+        return false;
+    }
+    const bool ok = std::fwrite(ticks.data(), sizeof(TickRecord), ticks.size(), f) == ticks.size();
+    return std::fclose(f) == 0 && ok;
+}
+
+}  // namespace merton
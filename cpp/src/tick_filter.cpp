@@ -0,0 +1,104 @@
+// -----------------------------------------------------------------------------
+// tick_filter.cpp
+// -----------------------------------------------------------------------------
+//
+// Tick prefilter (see tick_filter.hpp). Time bars close on the first tick
+// stamped in a later bar; floor division keeps bar ids monotone for
+// timestamps before the epoch too. A volume bar passes on the tick that
+// brings the accumulated volume to bar_size and restarts from zero, so one
+// large print closes at most one bar. An unusable bar_size (not finite, or
+// <= 0 for volume / < 1 us for time bars) disables bar sampling.
+// -----------------------------------------------------------------------------
+
+#include "tick_filter.hpp"
+
+#include <cmath>
+
+namespace merton {
+
+namespace {
+
+std::int64_t floor_div(std::int64_t a, std::int64_t b) {
+    const std::int64_t q = a / b;
+    return (a % b != 0 && (a < 0) != (b < 0)) ? q - 1 : q;
+}
+
+/// config.tick_bars, or none when bar_size is unusable (time bars are whole
+/// microseconds).
+TickBars bar_mode(const CalibratorConfig& config) {
+    const double b = config.bar_size;
+    const bool usable = std::isfinite(b) && (config.tick_bars == TickBars::time ? b >= 1.0 : b > 0.0);
+    return usable ? config.tick_bars : TickBars::none;
+}
+
+}  // namespace
+
+TickFilter::TickFilter(const CalibratorConfig& config)
+    : suppress_duplicates_(config.suppress_duplicate_prices),
+      min_dt_us_(config.min_tick_dt_us > 0 ? config.min_tick_dt_us : 0),
+      bars_(bar_mode(config)),
+      bar_size_(config.bar_size),
+      active_(suppress_duplicates_ || min_dt_us_ > 0 || bars_ != TickBars::none) {}
+
+std::optional<FilteredTick> TickFilter::push(double price, std::int64_t epoch_us, double volume) {
+    const FilteredTick tick{price, epoch_us};
+    switch (bars_) {
+        case TickBars::none:
+            return pass(tick);
+        case TickBars::time: {
+            const std::int64_t bar = floor_div(epoch_us, static_cast<std::int64_t>(bar_size_));
+            if (!open_) {
+                open_ = tick;
+                open_bar_ = bar;
+                return std::nullopt;
+            }
+            if (bar == open_bar_) {
+                open_ = tick;  // the previous tick of this bar is superseded
+                ++counts_.bar;
+                return std::nullopt;
+            }
+            const FilteredTick close = *open_;
+            open_ = tick;
+            open_bar_ = bar;
+            return pass(close);
+        }
+        case TickBars::volume:
+            if (std::isfinite(volume) && volume > 0.0) {
+                bar_volume_ += volume;
+            }
+            // The first tick opens the series; later ones wait for a full bar.
+            if (last_ && bar_volume_ < bar_size_) {
+                ++counts_.bar;
+                return std::nullopt;
+            }
+            bar_volume_ = 0.0;
+            return pass(tick);
+    }
+    return pass(tick);
+}
+
+/// Duplicate and min-dt stages on a sampled tick; on success it becomes last_.
+std::optional<FilteredTick> TickFilter::pass(const FilteredTick& tick) {
+    if (last_) {
+        if (suppress_duplicates_ && tick.price == last_->price) {
+            ++counts_.duplicate_price;
+            return std::nullopt;
+        }
+        if (min_dt_us_ > 0 && tick.epoch_us - last_->epoch_us < min_dt_us_) {
+            ++counts_.min_dt;
+            return std::nullopt;
+        }
+    }
+    last_ = tick;
+    return tick;
+}
+
+void TickFilter::reset() {
+    last_.reset();
+    open_.reset();
+    open_bar_ = 0;
+    bar_volume_ = 0.0;
+    counts_ = TickFilterCounts{};
+}
+
+}  // namespace merton
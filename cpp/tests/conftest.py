@@ -3,20 +3,42 @@ import pytest
 import merton_online_calibrator as moc
 
 
-def build_calibrator() -> moc.OnlineMertonCalibrator:
+def build_params() -> moc.MertonParams:
     p = moc.MertonParams()
     p.sigma = 0.44
     setattr(p, "lambda", 20.0)
     p.mu_j = 0.003
     p.delta_j = 0.01
+    return p
 
+
+def build_config(
+    return_quantum: float = 1e-9,
+    async_recalibration: bool = False,
+    search_mode: moc.SearchMode = moc.SearchMode.gauss_seidel,
+    optimizer: moc.OptimizerMode = moc.OptimizerMode.coordinate_search,
+    poisson_tail_eps: float = 1e-12,
+    heterogeneous_dt: bool = False,
+    mixture_eval: moc.MixtureEval = moc.MixtureEval.direct,
+) -> moc.CalibratorConfig:
     cfg = moc.CalibratorConfig()
     cfg.window_size = 2048
     cfg.min_points_for_update = 64
     cfg.update_every_n_returns = 32
     cfg.n_max = 10
     cfg.coordinate_steps = 2
-    return moc.OnlineMertonCalibrator(p, cfg)
+    cfg.return_quantum = return_quantum
+    cfg.async_recalibration = async_recalibration
+    cfg.search_mode = search_mode
+    cfg.optimizer = optimizer
+    cfg.poisson_tail_eps = poisson_tail_eps
+    cfg.heterogeneous_dt = heterogeneous_dt
+    cfg.mixture_eval = mixture_eval
+    return cfg
+
+
+def build_calibrator(**kwargs) -> moc.OnlineMertonCalibrator:
+    return moc.OnlineMertonCalibrator(build_params(), build_config(**kwargs))
 
 
 def feed_ticks(cal: moc.OnlineMertonCalibrator) -> tuple[float, int]:
@@ -31,8 +53,8 @@ def feed_ticks(cal: moc.OnlineMertonCalibrator) -> tuple[float, int]:
 
 
 class CalibratorHarness:
-    def __init__(self) -> None:
-        self.cal = build_calibrator()
+    def __init__(self, **config) -> None:
+        self.cal = build_calibrator(**config)
 
     def feed_ticks(self) -> tuple[float, int]:
         return feed_ticks(self.cal)
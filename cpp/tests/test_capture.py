@@ -0,0 +1,66 @@
+import math
+import struct
+
+import pytest
+
+from conftest import build_calibrator, feed_ticks
+
+# One block of 200 ticks: header, block, one 32-byte index entry, trailer.
+INDEX_AND_TRAILER_BYTES = 32 + 32
+
+
+@pytest.mark.capture
+def test_recording_is_compact_and_appends(tmp_path):
+    path = str(tmp_path / "ticks.mtk")
+
+    cal = build_calibrator()
+    assert not cal.is_recording()
+    assert cal.start_recording(path, 1e8)
+    assert cal.is_recording()
+    feed_ticks(cal)  # 200 ticks
+    assert cal.stop_recording()
+    assert not cal.is_recording()
+
+    first = (tmp_path / "ticks.mtk").read_bytes()
+    assert first[:8] == b"MRTNTCK1"
+    assert first[-8:] == b"MRTNIDX1"
+    # 16 bytes per tick would be the raw format.
+    assert len(first) < 200 * 16
+
+    again = build_calibrator()
+    assert again.start_recording(path, 1e8)
+    feed_ticks(again)
+    assert again.stop_recording()
+    second = (tmp_path / "ticks.mtk").read_bytes()
+    assert len(second) > len(first)
+    data_end = len(first) - INDEX_AND_TRAILER_BYTES
+    assert second[:data_end] == first[:data_end]
+
+    # A different price scale cannot be appended to the same file.
+    assert not build_calibrator().start_recording(path, 100.0)
+
+
+@pytest.mark.capture
+def test_recording_skips_unencodable_prices_and_survives_a_bad_index(tmp_path):
+    path = tmp_path / "ticks.mtk"
+
+    cal = build_calibrator()
+    assert cal.start_recording(str(path), 1e8)
+    price, ts = feed_ticks(cal)  # 200 ticks
+    for i, bad in enumerate((math.nan, math.inf, 1e20)):
+        cal.update_tick(bad, ts + 1 + i)
+    assert cal.stop_recording()
+    data = bytearray(path.read_bytes())
+    index_offset, block_count, tick_count = struct.unpack_from("=QQQ", data, len(data) - 32)
+    assert block_count == 1 and tick_count == 200
+
+    # An index entry pointing outside the data is ignored: the blocks are
+    # rescanned and appending resumes after them.
+    struct.pack_into("=Q", data, index_offset + 16, 1 << 40)
+    path.write_bytes(bytes(data))
+    again = build_calibrator()
+    assert again.start_recording(str(path), 1e8)
+    feed_ticks(again)
+    assert again.stop_recording()
+    data = path.read_bytes()
+    assert struct.unpack_from("=QQQ", data, len(data) - 32)[1:] == (2, 400)
@@ -1,7 +1,13 @@
 import math
+import random
+import time
 
 import pytest
 
+import merton_online_calibrator as moc
+
+from conftest import CalibratorHarness, build_calibrator, build_config, build_params, feed_ticks
+
 
 @pytest.mark.params
 def test_online_update_and_params_are_finite(calibrator):
@@ -14,3 +20,440 @@ def test_online_update_and_params_are_finite(calibrator):
     assert math.isfinite(params.mu_j)
     assert math.isfinite(params.delta_j)
     assert price > 0
+
+
+@pytest.mark.params
+@pytest.mark.parametrize(
+    "config",
+    [
+        {"return_quantum": 0.0},  # exact histogram vs quantized
+        {"poisson_tail_eps": 0.0},  # full series vs adaptive truncation
+        {"mixture_eval": moc.MixtureEval.log_sum_exp},  # log-space eval vs direct
+        {"mixture_eval": moc.MixtureEval.fast},
+    ],
+    ids=["exact_histogram", "full_series", "log_sum_exp", "fast"],
+)
+def test_likelihood_variants_match_default(calibrator, config):
+    calibrator.feed_ticks()
+    reference = calibrator.params()
+
+    variant = CalibratorHarness(**config)
+    variant.feed_ticks()
+    p = variant.params()
+
+    assert variant.sample_count() == calibrator.sample_count()
+    assert p.sigma == pytest.approx(reference.sigma, rel=1e-6)
+    assert getattr(p, "lambda") == pytest.approx(getattr(reference, "lambda"), rel=1e-6)
+    assert p.mu_j == pytest.approx(reference.mu_j, rel=1e-6, abs=1e-9)
+    assert p.delta_j == pytest.approx(reference.delta_j, rel=1e-6)
+
+
+@pytest.mark.params
+def test_kernel_width_follows_mixture_size():
+    one_second = 1.0 / (365.25 * 24 * 3600)
+    assert {"runtime", "n2", "n4", "n8", "n15"} <= set(moc.MixtureKernelWidth.__members__)
+
+    # lambda * dt ~ 6e-7: the tail cutoff keeps 2 terms.
+    assert build_calibrator().kernel_width(one_second) == moc.MixtureKernelWidth.n2
+    # Full series: n_max = 10 has no specialization, 8 does.
+    assert build_calibrator(poisson_tail_eps=0.0).kernel_width(one_second) == moc.MixtureKernelWidth.runtime
+    cfg = build_config(poisson_tail_eps=0.0)
+    cfg.n_max = 8
+    cal = moc.OnlineMertonCalibrator(build_params(), cfg)
+    assert cal.kernel_width(one_second) == moc.MixtureKernelWidth.n8
+
+
+@pytest.mark.params
+def test_jacobi_search_updates_params():
+    harness = CalibratorHarness(search_mode=moc.SearchMode.jacobi)
+    price, _ = harness.feed_ticks()
+    p = harness.params()
+
+    assert harness.cal.params_version() > 0
+    assert math.isfinite(p.sigma) and p.sigma > 0.0
+    assert math.isfinite(getattr(p, "lambda")) and getattr(p, "lambda") >= 0.0
+    assert math.isfinite(p.delta_j) and p.delta_j > 0.0
+    assert math.isfinite(harness.fair_value(price, 0.1, 8.0 / 8766.0, 0.0))
+
+
+@pytest.mark.params
+def test_lbfgsb_optimizer_stays_in_bounds():
+    harness = CalibratorHarness(optimizer=moc.OptimizerMode.lbfgsb)
+    price, _ = harness.feed_ticks()
+    p = harness.params()
+
+    assert harness.cal.params_version() > 0
+    assert 0.05 <= p.sigma <= 3.0
+    assert 0.01 <= getattr(p, "lambda") <= 40.0
+    assert -0.5 <= p.mu_j <= 0.5
+    assert 0.01 <= p.delta_j <= 1.0
+    assert math.isfinite(harness.fair_value(price, 0.1, 8.0 / 8766.0, 0.0))
+
+
+@pytest.mark.params
+def test_heterogeneous_dt_recovers_diffusion_vol():
+    # Pure diffusion (sigma = 0.8) sampled at exponential inter-arrival times:
+    # a single median dt misreads the spread of dts as excess kurtosis.
+    sigma = 0.8
+    secs_per_year = 365.25 * 24.0 * 3600.0
+
+    def run(heterogeneous_dt: bool) -> float:
+        cal = build_calibrator(optimizer=moc.OptimizerMode.lbfgsb, heterogeneous_dt=heterogeneous_dt)
+        gen = random.Random(11)
+        price = 68_000.0
+        ts = 1_700_000_000_000_000
+        for _ in range(20_000):
+            dt_s = max(0.001, gen.expovariate(0.5))
+            dt_y = dt_s / secs_per_year
+            price *= math.exp(-0.5 * sigma * sigma * dt_y + sigma * math.sqrt(dt_y) * gen.gauss(0.0, 1.0))
+            ts += int(dt_s * 1e6)
+            cal.update_tick(price, ts)
+            cal.maybe_update_params()
+        return cal.params().sigma
+
+    median_sigma = run(False)
+    bucketed_sigma = run(True)
+
+    assert abs(bucketed_sigma - sigma) < 0.1
+    assert abs(bucketed_sigma - sigma) < abs(median_sigma - sigma)
+
+
+@pytest.mark.params
+def test_dt_bucket_sub_bits_is_clamped():
+    cfg = build_config(heterogeneous_dt=True)
+    cfg.dt_bucket_sub_bits = 64  # would be a 2^64-bucket layout
+    cal = moc.OnlineMertonCalibrator(build_params(), cfg)
+    feed_ticks(cal)
+    assert math.isfinite(cal.params().sigma)
+    restored = moc.OnlineMertonCalibrator(build_params(), build_config())
+    assert restored.restore(cal.snapshot())
+    assert restored.sample_count() == cal.sample_count()
+
+
+def jump_heavy_calibrator(optimizer: moc.OptimizerMode) -> moc.OnlineMertonCalibrator:
+    # Daily returns, sigma = 0.5 and ~30 jumps/year of N(-0.02, 0.05^2): one
+    # recalibration over a full 4000-return window.
+    cfg = moc.CalibratorConfig()
+    cfg.window_size = 4000
+    cfg.min_points_for_update = 4000
+    cfg.update_every_n_returns = 4000
+    cfg.optimizer = optimizer
+    cal = moc.OnlineMertonCalibrator(moc.MertonParams(), cfg)
+
+    gen = random.Random(3)
+    dt = 1.0 / 365.25
+    lam, mu_j, delta_j, sigma = 30.0, -0.02, 0.05, 0.5
+    k = math.exp(mu_j + 0.5 * delta_j * delta_j) - 1.0
+    price = 100.0
+    ts = 1_700_000_000_000_000
+    cal.update_tick(price, ts)
+    for _ in range(4000):
+        x = (-lam * k - 0.5 * sigma * sigma) * dt + sigma * math.sqrt(dt) * gen.gauss(0.0, 1.0)
+        u, jumps, p_n = gen.random(), 0, math.exp(-lam * dt)
+        cdf = p_n
+        while u > cdf:
+            jumps += 1
+            p_n *= lam * dt / jumps
+            cdf += p_n
+        x += sum(gen.gauss(mu_j, delta_j) for _ in range(jumps))
+        price *= math.exp(x)
+        ts += 86_400_000_000
+        cal.update_tick(price, ts)
+    assert cal.maybe_update_params()
+    return cal
+
+
+@pytest.mark.params
+def test_em_beats_coordinate_search_in_fewer_passes():
+    em = jump_heavy_calibrator(moc.OptimizerMode.em)
+    coordinate = jump_heavy_calibrator(moc.OptimizerMode.coordinate_search)
+    p = em.params()
+
+    assert abs(p.sigma - 0.5) < 0.05
+    assert p.mu_j < 0.0 and 0.02 < p.delta_j < 0.1
+    s_em, s_cs = em.stats(), coordinate.stats()
+    if s_em.enabled:
+        assert s_em.last_nll < s_cs.last_nll
+        assert s_em.nll_evaluations <= s_cs.nll_evaluations
+        assert s_em.gradient_evaluations == 0
+
+
+@pytest.mark.params
+def test_online_em_seeds_from_batch_then_updates_per_tick():
+    cal = build_calibrator(optimizer=moc.OptimizerMode.online_em)
+    price, _ = feed_ticks(cal)
+    p = cal.params()
+
+    assert cal.params_version() > 0
+    assert 0.05 <= p.sigma <= 3.0
+    assert 0.01 <= getattr(p, "lambda") <= 40.0
+    assert math.isfinite(cal.fair_value(price, 0.1, 8.0 / 8766.0, 0.0))
+    stats = cal.stats()
+    if stats.enabled:
+        # Only the seeding recalibration passes over the window.
+        assert stats.recalibrations > 1
+        assert 0 < stats.nll_evaluations <= 25
+
+
+@pytest.mark.params
+def test_online_sgd_steps_every_tick_without_rescans():
+    cal = build_calibrator(optimizer=moc.OptimizerMode.online_sgd)
+    price, ts = feed_ticks(cal)
+    version = cal.params_version()
+    assert version > 0
+
+    price *= 1.0005
+    cal.update_tick(price, ts + 5_000_000)
+    assert cal.params_version() == version + 1
+    assert cal.maybe_update_params()
+
+    p = cal.params()
+    assert 0.05 <= p.sigma <= 3.0
+    assert 0.01 <= getattr(p, "lambda") <= 40.0
+    stats = cal.stats()
+    if stats.enabled:
+        assert stats.recalibrations == 0
+        assert stats.nll_evaluations == 0
+        assert stats.gradient_evaluations > 0
+
+
+@pytest.mark.params
+def test_global_search_recovers_from_vol_shift():
+    # sigma jumps 0.4 -> 1.8 after 4096 returns; with 8% coordinate steps the
+    # local search alone needs many recalibrations to follow.
+    secs_per_year = 365.25 * 24.0 * 3600.0
+
+    def run(starts: int) -> moc.OnlineMertonCalibrator:
+        cfg = build_config()
+        cfg.window_size = 1024
+        cfg.min_points_for_update = 512
+        cfg.update_every_n_returns = 256
+        cfg.global_search_starts = starts
+        cal = moc.OnlineMertonCalibrator(build_params(), cfg)
+        gen = random.Random(5)
+        dt_y = 5.0 / secs_per_year
+        price = 68_000.0
+        ts = 1_700_000_000_000_000
+        for i in range(4096 + 768 + 1):
+            if i == 4096 + 1:
+                pre_shift = cal.stats()
+                assert not pre_shift.enabled or pre_shift.global_searches == 0
+            sigma = 0.4 if i <= 4096 else 1.8
+            price *= math.exp(sigma * math.sqrt(dt_y) * gen.gauss(0.0, 1.0))
+            ts += 5_000_000
+            cal.update_tick(price, ts)
+            cal.maybe_update_params()
+        return cal
+
+    local = run(0)
+    multi = run(32)
+
+    assert multi.params().sigma > 1.2
+    assert multi.params().sigma > local.params().sigma + 0.3
+    stats = multi.stats()
+    if stats.enabled:
+        assert stats.global_searches > 0
+        assert stats.last_nll < local.stats().last_nll
+
+
+@pytest.mark.params
+def test_async_recalibration_publishes_params():
+    cal = build_calibrator(async_recalibration=True)
+    assert cal.is_async()
+    version = cal.params_version()
+
+    ts = 1_700_000_000_000_000
+    price = 68_000.0
+    for i in range(400):
+        price *= 1.0 + 0.0004 * (1 if (i % 3 == 0) else -0.5)
+        ts += 5_000_000
+        cal.update_tick(price, ts)
+
+    deadline = time.monotonic() + 10.0
+    while (cal.sample_count() < 399 or cal.params_version() == version) and time.monotonic() < deadline:
+        time.sleep(0.01)
+
+    assert cal.sample_count() == 399
+    assert cal.params_version() > version
+    assert cal.maybe_update_params()
+    assert math.isfinite(cal.fair_value(price, 0.10, 8.0 / (365.25 * 24.0), 0.0))
+
+
+@pytest.mark.params
+def test_update_ticks_matches_per_tick_ingestion():
+    np = pytest.importorskip("numpy")
+
+    ts = 1_700_000_000_000_000 + 5_000_000 * np.arange(200, dtype=np.int64)
+    steps = np.where(np.arange(200) % 2 == 0, 1.00005, 0.99995)
+    prices = 68_000.0 * np.cumprod(steps)
+    prices[10] = -1.0  # rejected like update_tick
+    ts[50] = ts[49]  # dt <= 0 rejected
+
+    batch = build_calibrator()
+    accepted = batch.update_ticks(prices, ts, recalibrate=True)
+
+    per_tick = build_calibrator()
+    expected = 0
+    for p, t in zip(prices.tolist(), ts.tolist()):
+        expected += per_tick.update_tick(p, t)
+        per_tick.maybe_update_params()
+
+    assert accepted == expected
+    assert batch.sample_count() == per_tick.sample_count()
+    assert batch.params().sigma == pytest.approx(per_tick.params().sigma)
+    with pytest.raises(ValueError):
+        batch.update_ticks(prices, ts[:-1])
+
+
+@pytest.mark.params
+def test_window_views_are_zero_copy_and_versioned():
+    np = pytest.importorskip("numpy")
+    cal = build_calibrator()
+    price, ts = feed_ticks(cal)
+
+    version = cal.window_version()
+    returns = cal.window_returns()
+    dts = cal.window_dt_us()
+    loglik = cal.window_log_likelihood()
+    assert version % 2 == 0 and cal.window_version() == version
+    assert len(returns) == len(dts) == len(loglik) == cal.sample_count() == 199
+    assert not returns.flags.writeable and not loglik.flags.writeable
+    assert dts.dtype == np.int64 and (dts == 5_000_000).all()
+    assert np.isfinite(loglik).all()
+    # Views of one window state alias the same storage.
+    assert np.shares_memory(returns, cal.window_returns())
+
+    cal.update_tick(price * 1.0001, ts + 5_000_000)
+    assert cal.window_version() == version + 2
+    grown = cal.window_returns()
+    assert len(grown) == 200
+    assert np.array_equal(grown[:-1], returns)
+    assert grown[-1] == pytest.approx(math.log(1.0001))
+
+    # Views keep their storage alive across restore() and the calibrator.
+    cal.restore(cal.snapshot())
+    assert cal.window_version() > version + 2
+    assert np.array_equal(cal.window_returns(), grown)
+    del cal
+    assert np.isfinite(grown).all() and len(grown) == 200
+
+
+@pytest.mark.params
+def test_calibrate_batch_and_rolling_series():
+    np = pytest.importorskip("numpy")
+
+    # One-minute ticks, pure diffusion at sigma = 0.5.
+    n = 20_001
+    dt_years = 60.0 / (365.25 * 24.0 * 3600.0)
+    rng = np.random.default_rng(7)
+    ts = 1_700_000_000_000_000 + 60_000_000 * np.arange(n, dtype=np.int64)
+    prices = 68_000.0 * np.exp(np.cumsum(0.5 * np.sqrt(dt_years) * rng.standard_normal(n)))
+
+    options = moc.BatchOptions()
+    options.threads = 2
+    fit = moc.calibrate_batch(prices, ts, build_params(), build_config(), options)
+    assert fit.returns == n - 1
+    assert fit.start_us == ts[0] and fit.end_us == ts[-1]
+    assert fit.sigma == pytest.approx(0.5, rel=0.1)
+
+    options.window = 5_000
+    series = moc.calibrate_rolling(prices, ts, build_params(), build_config(), options)
+    assert len(series) == 4
+    assert {"start_us", "end_us", "returns", "sigma", "lambda", "mu_j", "delta_j", "nll"} <= set(series.dtype.names)
+    window = moc.calibrate_batch(prices[5_000:10_001], ts[5_000:10_001], build_params(), build_config(), options)
+    assert series["start_us"][1] == window.start_us
+    assert series["sigma"][1] == pytest.approx(window.sigma)
+    assert series["nll"][1] == pytest.approx(window.nll)
+    with pytest.raises(ValueError):
+        moc.calibrate_batch(prices, ts[:-1])
+
+
+@pytest.mark.params
+def test_stats_count_ticks_rejections_and_searches():
+    cal = build_calibrator()
+    stats = cal.stats()
+    if not stats.enabled:
+        pytest.skip("built with MERTON_ENABLE_STATS=OFF")
+    assert stats.ticks == 0
+
+    feed_ticks(cal)
+    cal.update_tick(-1.0, 1_800_000_000_000_000)
+    stats = cal.stats()
+    assert stats.ticks == 201
+    assert stats.rejected_first_tick == 1
+    assert stats.rejected_price == 1
+    assert stats.returns_accepted == 199
+    assert stats.recalibrations > 0
+    assert stats.nll_evaluations > stats.recalibrations
+    assert stats.update_tick.count == 201
+    assert 0 < stats.update_tick.p50_ns <= stats.update_tick.max_ns
+
+    cal.reset_stats()
+    assert cal.stats().ticks == 0
+
+
+@pytest.mark.params
+def test_tick_filter_drops_and_reports_ticks():
+    ts0 = 1_700_000_000_000_000
+    # 1 ms quotes bouncing between two prices, each repeated three times.
+    cfg = build_config()
+    cfg.suppress_duplicate_prices = True
+    cfg.min_tick_dt_us = 10_000
+    cal = moc.OnlineMertonCalibrator(build_params(), cfg)
+    accepted = sum(cal.update_tick(100.0 + 0.5 * ((i // 3) % 2), ts0 + i * 1_000) for i in range(1_000))
+    counts = cal.filter_counts()
+    assert counts.duplicate_price > 0 and counts.min_dt > 0
+    assert accepted + cal.ticks_filtered() + 1 == 1_000
+    assert cal.sample_count() == accepted <= 100
+
+    # 1 s time bars over 10 s of ticks: nine closed bars, the first of which
+    # only sets the reference price.
+    cfg = build_config()
+    cfg.tick_bars = moc.TickBars.time
+    cfg.bar_size = 1e6
+    cal = moc.OnlineMertonCalibrator(build_params(), cfg)
+    accepted = sum(cal.update_tick(100.0 * (1.0 + 1e-4 * (i % 7)), ts0 + i * 1_000) for i in range(10_000))
+    assert accepted == cal.sample_count() == 8
+    assert cal.filter_counts().bar == cal.ticks_filtered() == 10_000 - 10
+
+    cal.restore(cal.snapshot())
+    assert cal.ticks_filtered() == 0
+
+
+@pytest.mark.params
+@pytest.mark.parametrize(
+    "search_mode,optimizer",
+    [
+        (moc.SearchMode.gauss_seidel, moc.OptimizerMode.coordinate_search),
+        (moc.SearchMode.jacobi, moc.OptimizerMode.coordinate_search),
+        (moc.SearchMode.gauss_seidel, moc.OptimizerMode.lbfgsb),
+        (moc.SearchMode.gauss_seidel, moc.OptimizerMode.em),
+        (moc.SearchMode.gauss_seidel, moc.OptimizerMode.online_em),
+        (moc.SearchMode.gauss_seidel, moc.OptimizerMode.online_sgd),
+    ],
+)
+def test_steady_state_cycle_does_not_allocate(search_mode, optimizer):
+    if not moc.allocation_counting_enabled():
+        pytest.skip("needs a Debug or MERTON_COUNT_ALLOCATIONS build")
+    cal = build_calibrator(search_mode=search_mode, optimizer=optimizer)
+    out = moc.MertonParams()
+    rng = random.Random(11)
+    ts = 1_700_000_000_000_000
+    price = 68_000.0
+
+    def cycle(n):
+        nonlocal ts, price
+        for _ in range(n):
+            price = round(price * (1.0 + 0.0002 * rng.gauss(0.0, 1.0)) * 2.0) / 2.0
+            ts += rng.randint(1, 5000) * 1000
+            cal.update_tick(price, ts)
+            cal.maybe_update_params()
+            cal.fair_value(price, 0.10, 8.0 / 8766.0, 0.0)
+            cal.params_into(out)
+
+    cycle(3000)  # warm-up: window full, histogram at its high-water mark
+    before = moc.allocation_count()
+    cycle(2000)
+    assert moc.allocation_count() == before
+    assert cal.params_into(out) == cal.params_version()
+    assert out.sigma == cal.params().sigma
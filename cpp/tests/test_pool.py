@@ -0,0 +1,81 @@
+import math
+import os
+
+import pytest
+
+import merton_online_calibrator as moc
+
+
+@pytest.mark.pool
+def test_pool_routes_ticks_per_symbol():
+    cfg = moc.CalibratorConfig()
+    cfg.window_size = 512
+    cfg.min_points_for_update = 64
+    cfg.update_every_n_returns = 32
+    cfg.n_max = 6
+    cfg.coordinate_steps = 1
+
+    pool = moc.CalibratorPool(cfg, 2)
+    symbols = ["XBTUSDT", "ETHUSDT", "SOLUSDT"]
+    for sym in symbols:
+        assert pool.add_symbol(sym, moc.MertonParams())
+    assert not pool.add_symbol("XBTUSDT", moc.MertonParams())
+    assert not pool.update_tick("UNKNOWN", 1.0, 1)
+
+    ts = 1_700_000_000_000_000
+    prices = {"XBTUSDT": 68_000.0, "ETHUSDT": 3_000.0, "SOLUSDT": 150.0}
+    for i in range(300):
+        ts += 1_000_000
+        for sym in symbols:
+            prices[sym] *= 1.0 + 0.0003 * (1 if (i % 3 == 0) else -0.5)
+            assert pool.update_tick(sym, prices[sym], ts)
+    pool.flush()
+
+    for sym in symbols:
+        st = pool.symbol_stats(sym)
+        assert st.queue_depth == 0
+        assert st.ticks_routed == 300
+        assert st.returns_accepted == 299
+        assert st.sample_count == 299
+        assert math.isfinite(pool.fair_value(sym, prices[sym], 0.1, 8.0 / (365.25 * 24.0), 0.0))
+
+    stats = pool.stats()
+    assert stats.symbols == 3
+    assert stats.threads == 2
+    assert stats.ticks_routed == 900
+    with pytest.raises(IndexError):
+        pool.params("UNKNOWN")
+
+
+@pytest.mark.pool
+def test_pool_slots_share_the_pool_threads():
+    if not os.path.isdir("/proc/self/task"):
+        pytest.skip("needs /proc thread listing")
+    cfg = moc.CalibratorConfig()
+    cfg.window_size = 512
+    cfg.min_points_for_update = 64
+    cfg.update_every_n_returns = 32
+    cfg.n_max = 6
+    cfg.coordinate_steps = 1
+    cfg.search_mode = moc.SearchMode.jacobi
+    cfg.global_search_starts = 8
+
+    threads_before = len(os.listdir("/proc/self/task"))
+    pool = moc.CalibratorPool(cfg, 2)
+    symbols = [f"SYM{i}" for i in range(8)]
+    for sym in symbols:
+        assert pool.add_symbol(sym, moc.MertonParams())
+    # Only the two shared workers: no slot builds its own search pool.
+    assert len(os.listdir("/proc/self/task")) == threads_before + 2
+
+    ts = 1_700_000_000_000_000
+    price = 100.0
+    for i in range(300):
+        ts += 1_000_000
+        price *= 1.0 + 0.0003 * (1 if (i % 3 == 0) else -0.5)
+        for sym in symbols:
+            assert pool.update_tick(sym, price, ts)
+    pool.flush()
+    for sym in symbols:
+        assert pool.symbol_stats(sym).sample_count == 299
+        assert math.isfinite(pool.params(sym).sigma)
@@ -2,6 +2,10 @@ import math
 
 import pytest
 
+import merton_online_calibrator as moc
+
+from conftest import build_calibrator, build_config, build_params
+
 
 @pytest.mark.pricing
 def test_fair_value_methods_are_finite_and_positive(calibrator):
@@ -15,3 +19,160 @@ def test_fair_value_methods_are_finite_and_positive(calibrator):
     assert math.isfinite(fv_ql)
     assert fv > 0.0
     assert fv_ql > 0.0
+
+
+@pytest.mark.pricing
+def test_quantlib_fair_value_tracks_rates_on_cached_curves(calibrator):
+    price, _ = calibrator.feed_ticks()
+    cal = calibrator.cal
+
+    # fair_value_quantlib rounds T to whole days and prices over the
+    # Actual/365F year fraction of that date, off flat continuous curves.
+    for days in (1, 7, 30, 365):
+        t_in = days / 365.25
+        t_ql = days / 365.0
+        # Changing r / q between calls only moves the SimpleQuotes under
+        # the cached curves; every call must see the new rates.
+        for q, r in ((0.10, 0.0), (0.25, 0.0), (0.25, 0.05), (-0.05, 0.03), (0.10, 0.0)):
+            assert cal.fair_value_quantlib(price, q, t_in, r) == pytest.approx(
+                cal.fair_value(price, q, t_ql, r), rel=1e-12
+            )
+    assert cal.fair_value_quantlib(price, 0.25, 1.0, 0.0) < cal.fair_value_quantlib(price, 0.10, 1.0, 0.0)
+
+
+@pytest.mark.pricing
+def test_fair_values_prices_a_horizon_ladder(calibrator):
+    np = pytest.importorskip("numpy")
+    price, _ = calibrator.feed_ticks()
+    cal = calibrator.cal
+
+    t_years = np.array([1.0, 8.0, 24.0, 168.0]) / (365.25 * 24.0)
+    out = np.empty_like(t_years)
+    cal.fair_values(np.array([price]), np.array([0.10]), t_years, np.array([0.0]), out)
+    for t, fv in zip(t_years, out):
+        assert fv == pytest.approx(cal.fair_value(price, 0.10, float(t), 0.0), rel=1e-15)
+
+    with pytest.raises(ValueError):
+        cal.fair_values(np.array([price]), np.array([0.1, 0.2]), t_years, np.array([0.0]), out)
+    with pytest.raises(ValueError):
+        cal.fair_values(np.array([price]), np.array([0.1]), t_years, np.array([0.0]), out[:2])
+
+
+@pytest.mark.pricing
+def test_quote_engine_matches_per_call_quote_path():
+    reference = build_calibrator()
+    qcfg = moc.QuoteEngineConfig()
+    qcfg.min_half_spread_bps = 2.0
+    engine = moc.QuoteEngine(build_params(), build_config(), qcfg)
+    q = moc.QuoteResult()
+
+    ts = 1_700_000_000_000_000
+    price = 68_000.0
+    funding_8h = 0.0001
+    for i in range(200):
+        price *= 1.0 + 0.00005 * (1 if (i % 2 == 0) else -1)
+        ts += 5_000_000
+        bid, ask = price - 0.5, price + 0.5
+        mid = (bid + ask) / 2
+        accepted = reference.update_tick(mid, ts)
+        updated = accepted and reference.maybe_update_params()
+        theo = reference.fair_value(mid, funding_8h * (365.25 * 24 / 8), qcfg.horizon_years, 0.0)
+        half = max(theo * 2.0 / 10000.0, (ask - bid) / 2)
+
+        assert engine.on_quote_into(bid, ask, ts, funding_8h, q)
+        assert q.tick_accepted == accepted
+        assert q.params_updated == updated
+        assert q.theo == pytest.approx(theo, rel=1e-15)
+        assert q.diff_bps == pytest.approx((theo - mid) / mid * 10000, abs=1e-9)
+        assert q.quote_bid == pytest.approx(theo - half, rel=1e-15)
+        assert q.quote_ask == pytest.approx(theo + half, rel=1e-15)
+
+    assert engine.calibrator().params().sigma == reference.params().sigma
+    assert not engine.on_quote(0.0, 68_000.0, ts + 1, funding_8h).valid
+
+
+def merton_call_reference(s0, strike, t, r, q, p, terms=range(200)):
+    # e^{-rT} sum_n P(lambda T, n) * Black(F_n, K, v_n), F_n = S0 e^{(r - q - lambda k) T} (1 + k)^n.
+    lam = getattr(p, "lambda")
+    k = math.exp(p.mu_j + 0.5 * p.delta_j**2) - 1.0
+    cdf = lambda x: 0.5 * math.erfc(-x / math.sqrt(2.0))
+    total = 0.0
+    for n in terms:
+        w = math.exp(-lam * t + n * math.log(lam * t) - math.lgamma(n + 1))
+        fwd = s0 * math.exp((r - q - lam * k) * t) * (1.0 + k) ** n
+        v = math.sqrt(p.sigma**2 * t + n * p.delta_j**2)
+        d1 = (math.log(fwd / strike) + 0.5 * v * v) / v
+        total += w * (fwd * cdf(d1) - strike * cdf(d1 - v))
+    return math.exp(-r * t) * total
+
+
+@pytest.mark.pricing
+def test_option_pricer_matches_merton_series():
+    np = pytest.importorskip("numpy")
+    p = build_params()
+    p.sigma = 0.6
+    p.mu_j = -0.03
+    p.delta_j = 0.05
+    t_years = np.array([1.0, 7.0, 30.0, 180.0]) / 365.25
+    strikes = np.linspace(80.0, 120.0, 9)
+
+    pricer = moc.MertonOptionPricer()
+    pricer.set_expiries(t_years, np.array([0.1]), np.array([0.04]))
+    assert math.isnan(pricer.price(100.0, 100.0, 0, moc.OptionRight.call))
+    assert pricer.update_params(p, 100)
+    assert not pricer.update_params(p, 100)  # cached series for this version
+    assert 0 < pricer.series_terms(0) < pricer.series_terms(3) < pricer.config().max_terms
+
+    calls = np.empty(len(t_years) * len(strikes))
+    puts = np.empty_like(calls)
+    deltas = np.empty_like(calls)
+    pricer.price_grid(100.0, strikes, moc.OptionRight.call, calls, deltas)
+    pricer.price_grid(100.0, strikes, moc.OptionRight.put, puts)  # deltas optional
+    for e, t in enumerate(t_years.tolist()):
+        for j, k in enumerate(strikes.tolist()):
+            i = e * len(strikes) + j
+            assert calls[i] == pytest.approx(merton_call_reference(100.0, k, t, 0.04, 0.1, p), abs=1e-9)
+            assert calls[i] - puts[i] == pytest.approx(100.0 * math.exp(-0.1 * t) - k * math.exp(-0.04 * t), abs=1e-9)
+            assert calls[i] == pricer.price(100.0, k, e, moc.OptionRight.call)
+    h = 1e-4
+    bump = (pricer.price(100.0 + h, 100.0, 2, moc.OptionRight.call) - pricer.price(100.0 - h, 100.0, 2, moc.OptionRight.call)) / (2 * h)
+    assert deltas[2 * len(strikes) + 4] == pytest.approx(bump, rel=1e-6)
+
+    cal = build_calibrator()
+    assert pricer.update_from(cal)
+    assert pricer.params_version() == cal.params_version()
+    assert pricer.params().sigma == cal.params().sigma
+    with pytest.raises(ValueError):
+        pricer.price_grid(100.0, strikes, moc.OptionRight.call, calls[:3], deltas)
+    with pytest.raises(TypeError):  # would only fill a converted copy
+        pricer.price_grid(100.0, strikes, moc.OptionRight.call, calls, deltas.astype(np.float32))
+
+
+@pytest.mark.pricing
+def test_option_pricer_handles_long_expiry_high_intensity():
+    np = pytest.importorskip("numpy")
+    p = moc.MertonParams()
+    p.sigma = 0.1
+    setattr(p, "lambda", 40.0)  # lambda' T ~ 800: exp(-lambda' T) underflows
+    p.mu_j = 0.01
+    p.delta_j = 0.01
+    t_years = np.array([20.0, math.inf])
+
+    truncated = moc.MertonOptionPricer()
+    truncated.set_expiries(t_years, np.array([0.0]), np.array([0.02]))
+    assert truncated.update_params(p, 1)
+    assert truncated.series_terms(0) == truncated.config().max_terms
+    assert math.isfinite(truncated.price(100.0, 100.0, 0, moc.OptionRight.call))
+    assert math.isnan(truncated.price(100.0, 100.0, 1, moc.OptionRight.call))
+
+    cfg = moc.OptionPricerConfig()
+    cfg.max_terms = 4096
+    pricer = moc.MertonOptionPricer(cfg)
+    pricer.set_expiries(t_years[:1], np.array([0.0]), np.array([0.02]))
+    assert pricer.update_params(p, 1)
+    assert pricer.series_terms(0) < cfg.max_terms
+    for k in (50.0, 100.0, 200.0):
+        call = pricer.price(100.0, k, 0, moc.OptionRight.call)
+        put = pricer.price(100.0, k, 0, moc.OptionRight.put)
+        assert call == pytest.approx(merton_call_reference(100.0, k, 20.0, 0.02, 0.0, p, range(1400)), abs=1e-9)
+        assert call - put == pytest.approx(100.0 - k * math.exp(-0.4), abs=1e-8)
@@ -0,0 +1,49 @@
+import os
+
+import pytest
+
+import merton_online_calibrator as moc
+
+from conftest import build_calibrator, feed_ticks
+
+
+@pytest.mark.shared
+def test_published_params_are_readable_from_shared_memory():
+    name = f"/merton_test_{os.getpid()}"
+    q, horizon = 0.1, 8.0 / (365.25 * 24.0)
+    assert not moc.SharedParamsReader(name).is_open()
+
+    cal = build_calibrator()
+    assert cal.start_publishing(name, q, horizon, 0.0)
+    assert cal.is_publishing()
+    try:
+        price, ts = feed_ticks(cal)
+        reader = moc.SharedParamsReader(name)
+        assert reader.is_open()
+        record = reader.read()
+        assert record.params_version == cal.params_version()
+        assert record.params.sigma == cal.params().sigma
+        assert record.s0 == price
+        assert record.epoch_us == ts
+        assert record.fair_value == pytest.approx(cal.fair_value(price, q, horizon, 0.0), rel=1e-15)
+
+        # One store per accepted tick.
+        before = reader.sequence()
+        cal.update_tick(price * 1.0001, ts + 5_000_000)
+        into = moc.SharedParams()
+        assert reader.read_into(into) == before + 1
+        assert into.s0 == price * 1.0001
+        # restore() republishes right away.
+        restored = build_calibrator()
+        assert restored.start_publishing(name, q, horizon, 0.0)
+        assert reader.read().params.sigma != cal.params().sigma
+        assert restored.restore(cal.snapshot())
+        assert reader.read().params.sigma == cal.params().sigma
+        restored.stop_publishing()
+        cal.stop_publishing()
+        assert not cal.is_publishing()
+        # The segment outlives the publisher until removed.
+        assert moc.SharedParamsReader(name).is_open()
+    finally:
+        assert moc.remove_shared_params(name)
+    assert not moc.SharedParamsReader(name).is_open()
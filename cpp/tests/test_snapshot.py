@@ -0,0 +1,80 @@
+import struct
+
+import pytest
+
+from conftest import build_calibrator, feed_ticks
+
+
+def _fnv1a(data):
+    h = 14695981039346656037
+    for b in data:
+        h = ((h ^ b) * 1099511628211) & 0xFFFFFFFFFFFFFFFF
+    return h
+
+
+def _with_checksum(body):
+    return bytes(body) + struct.pack("=Q", _fnv1a(body))
+
+
+def _expected_params(cal):
+    p = cal.params()
+    return (p.sigma, getattr(p, "lambda"), p.mu_j, p.delta_j)
+
+
+@pytest.mark.snapshot
+@pytest.mark.parametrize("return_quantum", [1e-9, 0.0])  # quantized / exact likelihood
+@pytest.mark.parametrize("async_recalibration", [False, True])
+def test_restore_resumes_from_snapshot(async_recalibration, return_quantum):
+    cal = build_calibrator(async_recalibration=async_recalibration, return_quantum=return_quantum)
+    price, ts = feed_ticks(cal)
+    blob = cal.snapshot()
+    assert blob[:8] == b"MRTNSNP1"
+
+    restored = build_calibrator(return_quantum=1e-6)
+    assert restored.restore(blob)
+    assert restored.sample_count() == cal.sample_count()
+    assert restored.is_async() == async_recalibration
+    if not async_recalibration:
+        assert _expected_params(restored) == _expected_params(cal)
+        # Same window and last tick: the next return is accepted and both
+        # calibrators keep moving in lockstep.
+        assert restored.update_tick(price * 1.0001, ts + 5_000_000)
+        assert cal.update_tick(price * 1.0001, ts + 5_000_000)
+        assert restored.snapshot() == cal.snapshot()
+
+
+@pytest.mark.snapshot
+def test_corrupt_snapshot_is_rejected(tmp_path):
+    cal = build_calibrator()
+    feed_ticks(cal)
+    blob = bytearray(cal.snapshot())
+    blob[40] ^= 0xFF
+
+    fresh = build_calibrator()
+    assert not fresh.restore(bytes(blob))
+    assert not fresh.restore(b"")
+    assert fresh.sample_count() == 0
+
+    path = str(tmp_path / "state.snap")
+    assert not fresh.load_snapshot(path)
+    assert cal.save_snapshot(path)
+    assert fresh.load_snapshot(path)
+    assert fresh.sample_count() == cal.sample_count()
+
+
+@pytest.mark.snapshot
+def test_snapshot_with_unusable_config_is_rejected_before_reset():
+    cal = build_calibrator()
+    feed_ticks(cal)
+    body = bytearray(cal.snapshot()[:-8])
+    config_offset = 16  # magic, version, sizeof(CalibratorConfig)
+
+    restored = build_calibrator()
+    feed_ticks(restored)
+    before = restored.snapshot()
+    for window_size in (0, 1 << 62):
+        bad = bytearray(body)
+        bad[config_offset : config_offset + 8] = struct.pack("=Q", window_size)
+        assert not restored.restore(_with_checksum(bad))
+    assert restored.snapshot() == before
+    assert restored.restore(_with_checksum(body))
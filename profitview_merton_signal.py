@@ -34,14 +34,24 @@ SIGMA = float(os.getenv("MERTON_SIGMA", 0.44))
 LAMBDA = float(os.getenv("MERTON_LAMBDA", 20.0))
 MU_J = float(os.getenv("MERTON_MU_J", 0.003))
 DELTA_J = float(os.getenv("MERTON_DELTA_J", 0.01))
+# Warm-start state file: restored at startup (params + return window, so the
+# bot quotes calibrated prices immediately) and rewritten periodically.
+# Empty disables.
+SNAPSHOT_PATH = os.getenv("MERTON_SNAPSHOT_PATH", "merton_state.snap")
+SNAPSHOT_EVERY_SEC = 300
+# Publish calibrator counters / latency percentiles (merton_stats topic).
+STATS_PUBLISH_SEC = 10
 
 # Horizon for theoretical price (8h = next funding window)
 T_HOURS = 8
 T_YEARS = T_HOURS / (365.25 * 24)
+# BitMEX funding rates are quoted per 8h interval; annualized in C++.
+FUNDING_INTERVAL_HOURS = 8
 
 # Refresh funding/mark from BitMEX API every 60 seconds
 FUNDING_REFRESH_SEC = 60
-# Log QuantLib helper divergence every N quote updates (0 disables)
+# The QuantLib helper (cached curves) is checked on every quote; the largest
+# divergence is logged every N quote updates (0 disables the check).
 QL_MONITOR_EVERY_N_QUOTES = 120
 # Minimum half-spread around theoretical fair value (in bps).
 MIN_HALF_SPREAD_BPS = 2.0
@@ -54,6 +64,8 @@ CPP_MIN_POINTS_FOR_UPDATE = 512
 CPP_UPDATE_EVERY_N_RETURNS = 128
 CPP_N_MAX = 15
 CPP_COORDINATE_STEPS = 3
+# Run the MLE search on a C++ worker thread instead of inside quote_update.
+CPP_ASYNC_RECALIBRATION = True
 
 
 def merton_theoretical(S0: float, sigma: float, lam: float, mu_j: float, delta_j: float,
@@ -64,27 +76,29 @@ def merton_theoretical(S0: float, sigma: float, lam: float, mu_j: float, delta_j
     return S0 * math.exp(drift * T_years)
 
 
-def funding_annual(rate_per_8h: float) -> float:
-    """Convert BitMEX funding rate (per 8h) to annualized."""
-    return rate_per_8h * (365.25 * 24 / 8)
-
-
 class Signals(Link):
     def __init__(self, *args, **kwargs):
         # Initialize state before Link.__init__ wires callbacks.
         self._lock = threading.Lock()
+        # Serializes calibrator ingestion with snapshot saves (cron thread).
+        self._cpp_lock = threading.Lock()
         self._funding_rate = 0.0
         self._mark_price = None
         self._sigma, self._lam, self._mu_j, self._delta_j = SIGMA, LAMBDA, MU_J, DELTA_J
-        self._cpp_calibrator = self._init_cpp_calibrator()
+        # One C++ call per quote: tick ingestion, params poll, theo and quote.
+        self._engine = self._init_quote_engine()
+        self._cpp_calibrator = self._engine.calibrator()
+        self._quote = moc.QuoteResult()
+        self._params_buf = moc.MertonParams()
         self._quote_count = 0
+        self._ql_max_gap_bps = 0.0
         super().__init__(*args, **kwargs)
 
     def on_start(self):
         self.refresh_funding()
 
-    def _init_cpp_calibrator(self):
-        """Initialize required C++ online calibrator."""
+    def _init_quote_engine(self):
+        """Initialize the required C++ quote engine and its online calibrator."""
         p = moc.MertonParams()
         p.sigma = self._sigma
         setattr(p, "lambda", self._lam)  # lambda is a Python keyword
@@ -97,26 +111,81 @@ class Signals(Link):
         cfg.update_every_n_returns = CPP_UPDATE_EVERY_N_RETURNS
         cfg.n_max = CPP_N_MAX
         cfg.coordinate_steps = CPP_COORDINATE_STEPS
+        cfg.async_recalibration = CPP_ASYNC_RECALIBRATION
+
+        qcfg = moc.QuoteEngineConfig()
+        qcfg.min_half_spread_bps = MIN_HALF_SPREAD_BPS
+        qcfg.funding_interval_hours = FUNDING_INTERVAL_HOURS
+        qcfg.horizon_years = T_YEARS
+        qcfg.rate = 0.0
 
         logger.info("Using required C++ online Merton calibrator")
-        return moc.OnlineMertonCalibrator(p, cfg)
+        engine = moc.QuoteEngine(p, cfg, qcfg)
+        cal = engine.calibrator()
+        if SNAPSHOT_PATH and os.path.exists(SNAPSHOT_PATH):
+            if cal.load_snapshot(SNAPSHOT_PATH):
+                q = cal.params()
+                self._sigma, self._lam, self._mu_j, self._delta_j = (
+                    float(q.sigma), float(getattr(q, "lambda")), float(q.mu_j), float(q.delta_j))
+                logger.info(f"Restored calibrator snapshot {SNAPSHOT_PATH}: {cal.sample_count()} returns")
+            else:
+                logger.warning(f"Ignoring unreadable calibrator snapshot {SNAPSHOT_PATH}")
+        return engine
+
+    def _refresh_params(self):
+        """Mirror newly published calibrator params into Python state."""
+        p = self._params_buf
+        self._cpp_calibrator.params_into(p)  # refreshed in place, no new object
+        with self._lock:
+            self._sigma = float(p.sigma)
+            self._lam = float(getattr(p, "lambda"))  # lambda is a Python keyword
+            self._mu_j = float(p.mu_j)
+            self._delta_j = float(p.delta_j)
 
-    def _tick_cpp_calibrator(self, price: float, epoch_ms: int):
-        """Push tick to C++ calibrator and pull updated params when available."""
-        if not price:
+    @cron.run(every=SNAPSHOT_EVERY_SEC)
+    def save_snapshot(self):
+        """Persist calibrator state for a warm restart."""
+        if not SNAPSHOT_PATH:
             return
-        try:
-            epoch_us = int(epoch_ms) * 1000
-            accepted = self._cpp_calibrator.update_tick(float(price), epoch_us)
-            if accepted and self._cpp_calibrator.maybe_update_params():
-                p = self._cpp_calibrator.params()
-                with self._lock:
-                    self._sigma = float(p.sigma)
-                    self._lam = float(getattr(p, "lambda"))  # lambda is a Python keyword
-                    self._mu_j = float(p.mu_j)
-                    self._delta_j = float(p.delta_j)
-        except Exception as e:
-            logger.error(f"C++ calibrator tick failed: {e}")
+        with self._cpp_lock:
+            ok = self._cpp_calibrator.save_snapshot(SNAPSHOT_PATH)
+        if not ok:
+            logger.error(f"Calibrator snapshot to {SNAPSHOT_PATH} failed")
+
+    @cron.run(every=STATS_PUBLISH_SEC)
+    def publish_stats(self):
+        """Stream calibrator instrumentation next to merton_theo."""
+        s = self._cpp_calibrator.stats()
+        if not s.enabled:
+            return
+
+        def latency(h):
+            return {"count": h.count, "mean_ns": h.mean_ns, "p50_ns": h.p50_ns, "p99_ns": h.p99_ns,
+                    "p999_ns": h.p999_ns, "max_ns": h.max_ns}
+
+        self.publish(
+            "merton_stats",
+            {
+                "sym": SYM,
+                "ticks": s.ticks,
+                "returns_accepted": s.returns_accepted,
+                "rejected": {
+                    "price": s.rejected_price,
+                    "first_tick": s.rejected_first_tick,
+                    "dt": s.rejected_dt,
+                    "non_finite": s.rejected_non_finite,
+                    "queue_full": s.rejected_queue_full,
+                },
+                "recalibrations": s.recalibrations,
+                "param_updates": s.param_updates,
+                "nll_evaluations": s.nll_evaluations,
+                "gradient_evaluations": s.gradient_evaluations,
+                "last_nll": s.last_nll,
+                "last_nll_improvement": s.last_nll_improvement,
+                "update_tick": latency(s.update_tick),
+                "recalibration": latency(s.recalibration),
+            },
+        )
 
     @cron.run(every=FUNDING_REFRESH_SEC)
     def refresh_funding(self):
@@ -142,47 +211,55 @@ class Signals(Link):
         mkt_bid, mkt_ask = data.get("bid", [0, 0])[0], data.get("ask", [0, 0])[0]
         if not mkt_bid or not mkt_ask:
             return
-        mid = (mkt_bid + mkt_ask) / 2
-        self._tick_cpp_calibrator(mid, int(data.get("time", self.epoch_now)))
         with self._lock:
-            q_annual = funding_annual(self._funding_rate)
-        theo = self._cpp_calibrator.fair_value(mid, q_annual, T_YEARS, 0.0)
-        diff = theo - mid
-        diff_bps = (diff / mid) * 10000 if mid else 0
-        min_half = theo * (MIN_HALF_SPREAD_BPS / 10000.0)
-        mkt_half = max((mkt_ask - mkt_bid) / 2.0, 0.0)
-        half_spread = max(min_half, mkt_half)
-        quote_bid = theo - half_spread
-        quote_ask = theo + half_spread
+            funding_rate = self._funding_rate
+        q = self._quote
+        try:
+            epoch_us = int(data.get("time", self.epoch_now)) * 1000
+            with self._cpp_lock:
+                ok = self._engine.on_quote_into(float(mkt_bid), float(mkt_ask), epoch_us, funding_rate, q)
+        except Exception as e:
+            logger.error(f"C++ quote engine failed: {e}")
+            return
+        if not ok:
+            return
+        if q.params_updated:
+            self._refresh_params()
         logger.info(
-            f"{sym} mid={mid:.2f} theo={theo:.2f} diff={diff:.2f} ({diff_bps:.1f} bps) "
-            f"quote=[{quote_bid:.2f}, {quote_ask:.2f}]"
+            f"{sym} mid={q.mid:.2f} theo={q.theo:.2f} ({q.diff_bps:.1f} bps) "
+            f"quote=[{q.quote_bid:.2f}, {q.quote_ask:.2f}]"
         )
 
-        # Monitoring: compare fast fair_value() with QuantLib helper periodically.
+        # Monitoring: compare fast fair_value() with the QuantLib helper.
         self._quote_count += 1
-        if QL_MONITOR_EVERY_N_QUOTES > 0 and (self._quote_count % QL_MONITOR_EVERY_N_QUOTES == 0):
+        if QL_MONITOR_EVERY_N_QUOTES > 0:
             try:
-                theo_ql = self._cpp_calibrator.fair_value_quantlib(mid, q_annual, T_YEARS, 0.0)
-                gap_bps = ((theo_ql - theo) / mid) * 10000 if mid else 0.0
-                logger.info(
-                    f"{sym} ql_monitor fast={theo:.2f} ql={theo_ql:.2f} gap={theo_ql-theo:.2f} ({gap_bps:.2f} bps)"
-                )
+                q_annual = self._engine.funding_annual(funding_rate)
+                theo_ql = self._cpp_calibrator.fair_value_quantlib(q.mid, q_annual, T_YEARS, 0.0)
+                gap_bps = ((theo_ql - q.theo) / q.mid) * 10000
+                if abs(gap_bps) > abs(self._ql_max_gap_bps):
+                    self._ql_max_gap_bps = gap_bps
+                if self._quote_count % QL_MONITOR_EVERY_N_QUOTES == 0:
+                    logger.info(
+                        f"{sym} ql_monitor fast={q.theo:.2f} ql={theo_ql:.2f} gap={theo_ql-q.theo:.2f} "
+                        f"({gap_bps:.2f} bps, max {self._ql_max_gap_bps:.2f} bps)"
+                    )
+                    self._ql_max_gap_bps = 0.0
             except Exception as e:
                 logger.warning(f"QuantLib monitor failed: {e}")
 
         # Publish two-sided quote around fair value for neutral/market-making behavior.
-        self.signal("bitmex", SYM, quote=[quote_bid, quote_ask])
+        self.signal("bitmex", SYM, quote=[q.quote_bid, q.quote_ask])
         # Stream to websocket for dashboards
         self.publish(
             "merton_theo",
             {
                 "sym": sym,
-                "market": mid,
-                "theo": theo,
-                "diff_bps": diff_bps,
-                "quote_bid": quote_bid,
-                "quote_ask": quote_ask,
+                "market": q.mid,
+                "theo": q.theo,
+                "diff_bps": q.diff_bps,
+                "quote_bid": q.quote_bid,
+                "quote_ask": q.quote_ask,
             },
         )
 